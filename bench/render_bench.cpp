@@ -0,0 +1,660 @@
+// Render benchmarks of synthetic component trees against the headless backend.
+// Build with -DQUC_HEADLESS=ON -DQUC_BENCHMARKS=ON, then run quc_bench --help.
+
+#include "shared/components/Text.hpp"
+#include "shared/components/Button.hpp"
+#include "shared/components/layouts/VerticalLayoutGroup.hpp"
+#include "shared/components/layouts/HorizontalLayoutGroup.hpp"
+#include "shared/RootContainer.hpp"
+#include "shared/KeyMap.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if __has_include(<malloc.h>)
+#include <malloc.h>
+#endif
+
+#pragma region allocation counting
+namespace {
+    struct AllocationCounters {
+        std::atomic<size_t> allocations = 0;
+        std::atomic<size_t> liveBytes = 0;
+    };
+
+    AllocationCounters counters;
+
+    // every block starts with its size, so delete knows how much is freed
+    constexpr size_t headerSize = alignof(std::max_align_t);
+
+    void* countedAlloc(size_t size, size_t align = headerSize) {
+        // over-aligned blocks keep the header in front of the aligned part
+        auto offset = std::max(align, headerSize);
+        auto block = static_cast<char*>(align > headerSize
+                ? std::aligned_alloc(align, (size + offset + align - 1) / align * align)
+                : std::malloc(size + offset));
+        if (!block) throw std::bad_alloc();
+        *reinterpret_cast<size_t*>(block + offset - headerSize) = size;
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.liveBytes.fetch_add(size, std::memory_order_relaxed);
+        return block + offset;
+    }
+
+    void countedFree(void* ptr, size_t align = headerSize) noexcept {
+        if (!ptr) return;
+        auto offset = std::max(align, headerSize);
+        auto block = static_cast<char*>(ptr) - offset;
+        counters.liveBytes.fetch_sub(*reinterpret_cast<size_t*>(block + offset - headerSize), std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void operator delete(void* ptr) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { countedFree(ptr); }
+// std::pmr::new_delete_resource allocates through these, whatever the alignment
+void* operator new(size_t size, std::align_val_t align) { return countedAlloc(size, static_cast<size_t>(align)); }
+void* operator new[](size_t size, std::align_val_t align) { return countedAlloc(size, static_cast<size_t>(align)); }
+void operator delete(void* ptr, std::align_val_t align) noexcept { countedFree(ptr, static_cast<size_t>(align)); }
+void operator delete[](void* ptr, std::align_val_t align) noexcept { countedFree(ptr, static_cast<size_t>(align)); }
+void operator delete(void* ptr, size_t, std::align_val_t align) noexcept { countedFree(ptr, static_cast<size_t>(align)); }
+void operator delete[](void* ptr, size_t, std::align_val_t align) noexcept { countedFree(ptr, static_cast<size_t>(align)); }
+#pragma endregion
+
+namespace {
+    using namespace QUC;
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Keeps a result the benchmark computed only to measure it from being optimized away
+    template<typename T>
+    inline void doNotOptimize(T const& value) {
+        asm volatile("" : : "r"(value) : "memory");
+    }
+
+#pragma region synthetic trees
+    struct BranchState {
+        UnityEngine::UI::VerticalLayoutGroup* layout = nullptr;
+        detail::KeyedList list;
+    };
+
+    /// @brief A layout with a label and any amount of nested branches, for trees of any shape
+    struct Branch {
+        const Key key;
+        Text label;
+        std::vector<Branch> children;
+
+        explicit Branch(std::string_view text) : label(text) {}
+
+        UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
+            auto& state = data.getData<BranchState>();
+            if (!state.layout) {
+                state.layout = QUC_NATIVE_CALL(Backend::createVerticalLayoutGroup(&ctx.parentTransform));
+            }
+
+            auto& childCtx = data.getChildContext([&state] {
+                return state.layout->get_transform();
+            });
+            detail::renderSingle(label, childCtx);
+            detail::renderKeyedList(std::span(children), childCtx, state.list);
+            return &childCtx.parentTransform;
+        }
+    };
+
+    using Row = detail::HorizontalLayoutGroup<Text, Button, Text>;
+
+    Row makeRow(size_t i) {
+        return Row(Text("Name " + std::to_string(i)), Button("Edit", [](Button&, UnityEngine::Transform*, RenderContext&) {}), Text(std::to_string(i)));
+    }
+
+    /// @brief A synthetic tree, and a text deep inside of it to modify
+    struct Tree {
+        std::string name;
+        size_t nodes;
+        std::function<void(RenderContext&)> render;
+        std::function<void(size_t)> modifyLeaf;
+    };
+
+    template<typename T>
+    Tree makeTree(std::string name, size_t nodes, std::shared_ptr<T> root, std::function<void(T&, size_t)> modify) {
+        return {
+            std::move(name), nodes,
+            [root](RenderContext& ctx) { detail::renderSingle(*root, ctx); },
+            [root, modify](size_t iteration) { modify(*root, iteration); }
+        };
+    }
+
+    /// @brief A chain of nested layouts
+    Tree deepTree(size_t depth) {
+        auto root = std::make_shared<Branch>("depth 0");
+        auto branch = root.get();
+        for (size_t i = 1; i < depth; i++) {
+            branch->children.emplace_back("depth " + std::to_string(i));
+            branch = &branch->children.back();
+        }
+        // branch + label per level
+        return makeTree<Branch>("deep" + std::to_string(depth), depth * 2, root, [](Branch& root, size_t iteration) {
+            auto branch = &root;
+            while (!branch->children.empty()) branch = &branch->children.back();
+            branch->label.text = "leaf " + std::to_string(iteration);
+        });
+    }
+
+    /// @brief One layout with many nested layouts
+    Tree wideTree(size_t width) {
+        auto root = std::make_shared<Branch>("root");
+        root->children.reserve(width);
+        for (size_t i = 0; i < width; i++) {
+            root->children.emplace_back("child " + std::to_string(i));
+        }
+        return makeTree<Branch>("wide" + std::to_string(width), 2 + width * 2, root, [](Branch& root, size_t iteration) {
+            root.children[root.children.size() / 2].label.text = "leaf " + std::to_string(iteration);
+        });
+    }
+
+    /// @brief Rows of texts and buttons in layout groups
+    Tree mixedTree(size_t rows) {
+        using List = detail::VariableContainer<Row>;
+        using Root = detail::VerticalLayoutGroup<Text, List>;
+
+        std::vector<Row> children;
+        children.reserve(rows);
+        for (size_t i = 0; i < rows; i++) {
+            children.push_back(makeRow(i));
+        }
+        auto root = std::make_shared<Root>(Text("Header"), List(children));
+        // root, header, list + row layout and its three children
+        return makeTree<Root>("mixed" + std::to_string(rows), 3 + rows * 4, root, [](Root& root, size_t iteration) {
+            auto& list = std::get<1>(root.children).children;
+            std::get<2>(list[list.size() / 2].children).text = std::to_string(iteration);
+        });
+    }
+
+    /// @brief A long flat list of texts, like a table of descriptors
+    Tree listTree(size_t count) {
+        using List = detail::VariableContainer<Text>;
+
+        std::vector<Text> texts;
+        texts.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            texts.emplace_back("Descriptor " + std::to_string(i));
+        }
+        auto root = std::make_shared<List>(texts);
+        return makeTree<List>("list" + std::to_string(count), 1 + count, root, [](List& list, size_t iteration) {
+            list.children[list.children.size() / 2].text = "Descriptor " + std::to_string(iteration);
+        });
+    }
+#pragma endregion
+
+#pragma region measuring
+    struct Sample {
+        uint64_t ns;
+        size_t allocations;
+        long long retainedBytes;
+    };
+
+    template<typename F>
+    Sample measure(F&& f) {
+        auto allocations = counters.allocations.load();
+        auto liveBytes = static_cast<long long>(counters.liveBytes.load());
+        auto start = Clock::now();
+        f();
+        auto end = Clock::now();
+        return {
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()),
+            counters.allocations.load() - allocations,
+            static_cast<long long>(counters.liveBytes.load()) - liveBytes
+        };
+    }
+
+    struct Result {
+        std::string tree;
+        std::string scenario;
+        size_t nodes;
+        double nsPerNode;
+        double allocationsPerNode;
+        long long retainedBytes;
+        /// @brief Most allocations of any single run, not only the median one
+        size_t maxAllocations;
+    };
+
+    constexpr char const* scenarios[] = {"mount", "noop", "leaf", "teardown"};
+
+    /// @brief Runs every scenario iterations times on a fresh context, keeping the median of each
+    std::vector<Result> run(Tree& tree, size_t iterations) {
+        std::map<std::string, std::vector<Sample>> samples;
+
+        for (size_t i = 0; i < iterations; i++) {
+            auto root = Backend::createObject("Root");
+            {
+                RenderContext ctx(root->get_transform());
+
+                samples["mount"].push_back(measure([&] { tree.render(ctx); }));
+                samples["noop"].push_back(measure([&] { tree.render(ctx); }));
+                samples["leaf"].push_back(measure([&] {
+                    tree.modifyLeaf(i);
+                    tree.render(ctx);
+                }));
+                samples["teardown"].push_back(measure([&] { ctx.destroyTree(); }));
+            }
+            Backend::reset();
+        }
+
+        std::vector<Result> results;
+        for (auto scenario : scenarios) {
+            auto& list = samples[scenario];
+            std::sort(list.begin(), list.end(), [](Sample const& a, Sample const& b) { return a.ns < b.ns; });
+            auto const& median = list[list.size() / 2];
+            auto most = std::max_element(list.begin(), list.end(), [](Sample const& a, Sample const& b) { return a.allocations < b.allocations; });
+            results.push_back({
+                tree.name, scenario, tree.nodes,
+                static_cast<double>(median.ns) / static_cast<double>(tree.nodes),
+                static_cast<double>(median.allocations) / static_cast<double>(tree.nodes),
+                median.retainedBytes, most->allocations
+            });
+        }
+        return results;
+    }
+#pragma endregion
+
+#pragma region micro benchmarks
+    /// @brief A benchmark of a single operation instead of a tree, reported per operation instead of per node
+    struct Micro {
+        /// @brief Reported as the tree
+        std::string group;
+        std::string scenario;
+        size_t operations;
+        /// @brief Does the operations, measured
+        std::function<void()> run;
+        /// @brief Prepares the next run, not measured
+        std::function<void()> setup = [] {};
+        /// @brief Cleans up after a run, not measured
+        std::function<void()> teardown = [] {};
+    };
+
+    /// @brief Runs micro iterations times, keeping the median
+    Result run(Micro& micro, size_t iterations) {
+        std::vector<Sample> samples;
+        for (size_t i = 0; i < iterations; i++) {
+            micro.setup();
+            samples.push_back(measure(micro.run));
+            micro.teardown();
+        }
+
+        std::sort(samples.begin(), samples.end(), [](Sample const& a, Sample const& b) { return a.ns < b.ns; });
+        auto const& median = samples[samples.size() / 2];
+        auto most = std::max_element(samples.begin(), samples.end(), [](Sample const& a, Sample const& b) { return a.allocations < b.allocations; });
+        return {
+            micro.group, micro.scenario, micro.operations,
+            static_cast<double>(median.ns) / static_cast<double>(micro.operations),
+            static_cast<double>(median.allocations) / static_cast<double>(micro.operations),
+            median.retainedBytes, most->allocations
+        };
+    }
+
+    /// @brief Writes to HeldData and resolving them to components, see detail::DirtyTracker
+    void writeBenchmarks(std::vector<Micro>& micros) {
+        // two fields written in turns without rendering, used to grow the pending writes without bound
+        static HeldData<int> first;
+        static HeldData<int> second;
+        constexpr size_t alternating = 2'000'000;
+        micros.push_back({"writes", "alternating", alternating, [] {
+            for (size_t i = 0; i < alternating / 2; i++) {
+                first = static_cast<int>(i);
+                second = static_cast<int>(i);
+            }
+        }});
+
+        // as many different fields as the pending writes of a thread hold, then resolving them
+        static std::vector<HeldData<int>> fields(detail::PendingWrites::capacity);
+        micros.push_back({"writes", "distinct", fields.size(), [] {
+            for (auto& field : fields) field = *field + 1;
+            detail::DirtyTracker::flush();
+        }});
+
+        // Writing to a field no rendered component holds (a temporary component, or state outside of the tree),
+        // then rendering a mounted tree. Used to render the whole tree again.
+        static Tree tree = wideTree(1000);
+        static std::optional<RenderContext> ctx;
+        micros.push_back({"writes", "unowned", tree.nodes, [] {
+            first = *first + 1;
+            tree.render(*ctx);
+        }, [] {
+            ctx.emplace(Backend::createObject("Root")->get_transform());
+            tree.render(*ctx);
+        }, [] {
+            ctx->destroyTree();
+            ctx.reset();
+            Backend::reset();
+        }});
+    }
+
+    /// @brief Creating Keys from the per-thread block counter, against the clock they used to be read from
+    void keyBenchmarks(std::vector<Micro>& micros) {
+        constexpr size_t count = 1'000'000;
+        constexpr size_t threads = 4;
+
+        // what Key() did before KeyAllocator
+        auto clockKey = [] {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::high_resolution_clock::now().time_since_epoch()).count());
+        };
+
+        static std::vector<Key> keys;
+        static std::vector<uint64_t> seeds;
+        auto reserve = [] {
+            keys.clear();
+            keys.reserve(count);
+            seeds.clear();
+            seeds.reserve(count);
+        };
+
+        micros.push_back({"keys", "counter", count, [] {
+            for (size_t i = 0; i < count; i++) keys.emplace_back();
+        }, reserve});
+        micros.push_back({"keys", "clock", count, [clockKey] {
+            for (size_t i = 0; i < count; i++) seeds.push_back(clockKey());
+        }, reserve});
+
+        // each thread fills its own part, so only creating the keys is shared
+        auto fillInThreads = [](auto&& fill) {
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < threads; t++) {
+                workers.emplace_back([&fill, t] { fill(t * count / threads, (t + 1) * count / threads); });
+            }
+            for (auto& worker : workers) worker.join();
+        };
+        micros.push_back({"keys", "counter-threads", count, [fillInThreads] {
+            static std::vector<std::optional<Key>> slots(count);
+            fillInThreads([](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) slots[i].emplace();
+            });
+        }});
+        micros.push_back({"keys", "clock-threads", count, [fillInThreads, clockKey] {
+            static std::vector<uint64_t> slots(count);
+            fillInThreads([&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) slots[i] = clockKey();
+            });
+        }});
+    }
+
+    /// @brief Rendering a mounted keyed list again after its children changed order, or a child was inserted
+    void keyedListBenchmarks(std::vector<Micro>& micros) {
+        struct State {
+            std::vector<Text> items;
+            std::vector<Text> next;
+            std::optional<RenderContext> ctx;
+            std::optional<detail::KeyedList> list;
+        };
+
+        for (auto [count, size] : {std::pair<size_t, char const*>{1000, "1k"}, {10'000, "10k"}}) {
+            auto state = std::make_shared<State>();
+            for (size_t i = 0; i < count; i++) {
+                state->items.emplace_back("Item " + std::to_string(i));
+            }
+
+            // mounts the items, then prepares the next list with reorder(items, next)
+            auto setup = [state](auto reorder) {
+                return [state, reorder] {
+                    state->ctx.emplace(Backend::createObject("Root")->get_transform());
+                    state->list.emplace();
+                    detail::renderKeyedList(std::span(state->items), *state->ctx, *state->list);
+                    // Text can't be assigned, the next list is only ever appended to
+                    state->next.clear();
+                    state->next.reserve(state->items.size() + 1);
+                    reorder(state->items, state->next);
+                };
+            };
+            auto render = [state] {
+                detail::renderKeyedList(std::span(state->next), *state->ctx, *state->list);
+            };
+            auto teardown = [state] {
+                state->ctx->destroyTree();
+                state->ctx.reset();
+                state->list.reset();
+                Backend::reset();
+            };
+
+            micros.push_back({"keyedlist", std::string("reverse-") + size, count, render, setup([](auto& items, auto& next) {
+                for (auto it = items.rbegin(); it != items.rend(); it++) next.push_back(*it);
+            }), teardown});
+            micros.push_back({"keyedlist", std::string("move-") + size, count, render, setup([](auto& items, auto& next) {
+                next.push_back(items.back());
+                for (size_t i = 0; i + 1 < items.size(); i++) next.push_back(items[i]);
+            }), teardown});
+            micros.push_back({"keyedlist", std::string("insert-") + size, count, render, setup([](auto& items, auto& next) {
+                for (size_t i = 0; i < items.size(); i++) {
+                    if (i == items.size() / 2) next.emplace_back("Inserted");
+                    next.push_back(items[i]);
+                }
+            }), teardown});
+        }
+    }
+
+    /// @brief The maps of a keymap scenario, with as many entries in total at every size
+    template<typename Map>
+    struct MapSet {
+        static constexpr size_t entries = 100'000;
+
+        std::vector<Key> keys;
+        std::vector<Map> maps;
+        size_t perMap;
+
+        explicit MapSet(size_t perMap) : keys(entries), perMap(perMap) {}
+
+        /// @brief Reserves each map for its entries first, like containers do for their children on the first render
+        void fill() {
+            maps.resize(entries / perMap);
+            for (auto& map : maps) map.reserve(perMap);
+            for (size_t i = 0; i < entries; i++) maps[i / perMap][keys[i]].lastVisit = static_cast<uint32_t>(i);
+        }
+    };
+
+    inline RenderContextChildData* lookup(KeyMap<RenderContextChildData>& map, Key const& key) {
+        return map.find(key);
+    }
+
+    inline RenderContextChildData* lookup(std::unordered_map<Key, RenderContextChildData>& map, Key const& key) {
+        auto it = map.find(key);
+        return it == map.end() ? nullptr : &it->second;
+    }
+
+    /// @brief Lookup, insertion and erasure of the child data of a context, at 10, 1k and 100k children
+    template<typename Map>
+    void mapBenchmarks(std::vector<Micro>& micros, std::string const& suffix) {
+        for (auto [perMap, size] : {std::pair<size_t, char const*>{10, "10"}, {1000, "1k"}, {100'000, "100k"}}) {
+            auto set = std::make_shared<MapSet<Map>>(perMap);
+            auto name = [&](char const* op) { return std::string(op) + "-" + size + suffix; };
+            auto clear = [set] { set->maps.clear(); };
+
+            // what stays allocated afterwards is the memory of MapSet::entries children
+            micros.push_back({"keymap", name("insert"), MapSet<Map>::entries, [set] { set->fill(); }, clear, clear});
+
+            constexpr size_t rounds = 10;
+            micros.push_back({"keymap", name("lookup"), MapSet<Map>::entries * rounds, [set] {
+                uint32_t sum = 0;
+                for (size_t round = 0; round < rounds; round++) {
+                    for (size_t i = 0; i < MapSet<Map>::entries; i++) {
+                        sum += lookup(set->maps[i / set->perMap], set->keys[i])->lastVisit;
+                    }
+                }
+                doNotOptimize(sum);
+            }, [set] { set->fill(); }, clear});
+
+            micros.push_back({"keymap", name("erase"), MapSet<Map>::entries, [set] {
+                for (size_t i = 0; i < MapSet<Map>::entries; i++) set->maps[i / set->perMap].erase(set->keys[i]);
+            }, [set] { set->fill(); }, clear});
+        }
+    }
+#pragma endregion
+
+#pragma region reporting
+    /// @brief One result per line, so a baseline can be read back without a JSON library
+    void writeJson(std::ostream& out, std::vector<Result> const& results) {
+        out << "{\"benchmarks\":[\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            auto const& result = results[i];
+            out << "{\"tree\":\"" << result.tree << "\",\"scenario\":\"" << result.scenario << "\",\"nodes\":" << result.nodes
+                << ",\"ns_per_node\":" << result.nsPerNode << ",\"allocs_per_node\":" << result.allocationsPerNode
+                << ",\"bytes_retained\":" << result.retainedBytes << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]}\n";
+    }
+
+    std::string field(std::string const& line, std::string const& name) {
+        auto key = "\"" + name + "\":";
+        auto start = line.find(key);
+        if (start == std::string::npos) return {};
+        start += key.size();
+        if (line[start] == '"') {
+            return line.substr(start + 1, line.find('"', start + 1) - start - 1);
+        }
+        return line.substr(start, line.find_first_of(",}", start) - start);
+    }
+
+    std::map<std::string, Result> readBaseline(std::string const& path) {
+        std::map<std::string, Result> baseline;
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line)) {
+            auto tree = field(line, "tree");
+            if (tree.empty()) continue;
+
+            Result result{tree, field(line, "scenario"), std::stoul(field(line, "nodes")),
+                          std::stod(field(line, "ns_per_node")), std::stod(field(line, "allocs_per_node")),
+                          std::stoll(field(line, "bytes_retained")), 0};
+            baseline[result.tree + "/" + result.scenario] = result;
+        }
+        return baseline;
+    }
+
+    /// @return The amount of regressions: slower than tolerance allows, or more allocations
+    size_t compare(std::vector<Result> const& results, std::map<std::string, Result> const& baseline, double tolerance) {
+        size_t regressions = 0;
+        std::printf("%-12s %-9s %12s %12s %8s %10s %10s\n", "tree", "scenario", "ns/node", "baseline", "change", "allocs", "baseline");
+        for (auto const& result : results) {
+            auto it = baseline.find(result.tree + "/" + result.scenario);
+            if (it == baseline.end()) {
+                std::printf("%-12s %-9s %12.2f %12s\n", result.tree.c_str(), result.scenario.c_str(), result.nsPerNode, "new");
+                continue;
+            }
+
+            auto const& base = it->second;
+            double change = base.nsPerNode > 0 ? result.nsPerNode / base.nsPerNode - 1 : 0;
+            bool slower = change > tolerance;
+            // one allocation per thousand nodes of slack, strings of the modified leaf differ in length between runs
+            bool allocates = result.allocationsPerNode > base.allocationsPerNode + 1e-3;
+            if (slower || allocates) regressions++;
+
+            std::printf("%-12s %-9s %12.2f %12.2f %+7.1f%% %10.3f %10.3f%s\n", result.tree.c_str(), result.scenario.c_str(),
+                        result.nsPerNode, base.nsPerNode, change * 100, result.allocationsPerNode, base.allocationsPerNode,
+                        slower || allocates ? "  REGRESSION" : "");
+        }
+        return regressions;
+    }
+#pragma endregion
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = 5;
+    std::string outPath;
+    std::string baselinePath;
+    double tolerance = 0.10;
+    std::string filter;
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        auto value = [&] { return i + 1 < argc ? std::string(argv[++i]) : std::string(); };
+        if (arg == "--iterations") iterations = std::max<size_t>(1, std::stoul(value()));
+        else if (arg == "--out") outPath = value();
+        else if (arg == "--baseline") baselinePath = value();
+        else if (arg == "--tolerance") tolerance = std::stod(value());
+        else if (arg == "--filter") filter = value();
+        else {
+            std::puts("usage: quc_bench [--iterations n] [--out results.json] [--baseline baseline.json] [--tolerance 0.10] [--filter name]\n"
+                      "Writes results as JSON to --out (or stdout). With --baseline, compares against a previous run and\n"
+                      "exits with 1 if any scenario got slower than the tolerance allows or allocates more per node.\n"
+                      "With --filter, only runs the trees and micro benchmark groups whose name contains name.");
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+
+#ifdef M_TRIM_THRESHOLD
+    // glibc raises both thresholds the first time a large block is freed, so until then every scenario that frees its
+    // memory hands it back to the system and page faults on it again. Fixed thresholds keep timings independent of order.
+    mallopt(M_MMAP_THRESHOLD, 64 * 1024 * 1024);
+    mallopt(M_TRIM_THRESHOLD, 128 * 1024 * 1024);
+#endif
+
+    // Measure creating and destroying, not pooling. The pools would also outlive Backend::reset().
+    NativePool<Text>::setCapacity(0);
+    NativePool<Button>::setCapacity(0);
+    NativePool<UnityEngine::UI::VerticalLayoutGroup>::setCapacity(0);
+    NativePool<UnityEngine::UI::HorizontalLayoutGroup>::setCapacity(0);
+
+    std::vector<Tree> trees;
+    trees.push_back(deepTree(256));
+    trees.push_back(wideTree(1000));
+    trees.push_back(mixedTree(1000));
+    trees.push_back(listTree(10000));
+
+    std::vector<Micro> micros;
+    writeBenchmarks(micros);
+    keyBenchmarks(micros);
+    keyedListBenchmarks(micros);
+    mapBenchmarks<KeyMap<RenderContextChildData>>(micros, "");
+    mapBenchmarks<std::unordered_map<Key, RenderContextChildData>>(micros, "-unordered_map");
+
+    std::vector<Result> results;
+    for (auto& tree : trees) {
+        if (tree.name.find(filter) == std::string::npos) continue;
+        auto treeResults = run(tree, iterations);
+        results.insert(results.end(), treeResults.begin(), treeResults.end());
+    }
+    for (auto& micro : micros) {
+        if (micro.group.find(filter) == std::string::npos) continue;
+        results.push_back(run(micro, iterations));
+    }
+
+    if (outPath.empty()) {
+        writeJson(std::cout, results);
+    } else {
+        std::ofstream out(outPath);
+        writeJson(out, results);
+    }
+
+    int status = 0;
+    // Re-rendering a mounted tree without state changes must not allocate at all, see docs/README.md
+    for (auto const& result : results) {
+        if (result.scenario == "noop" && result.maxAllocations > 0) {
+            std::fprintf(stderr, "%s: re-rendering without changes allocated %zu time(s)\n", result.tree.c_str(), result.maxAllocations);
+            status = 1;
+        }
+    }
+
+    if (!baselinePath.empty()) {
+        auto regressions = compare(results, readBaseline(baselinePath), tolerance);
+        if (regressions > 0) {
+            std::printf("%zu regression(s)\n", regressions);
+            status = 1;
+        }
+    }
+    return status;
+}
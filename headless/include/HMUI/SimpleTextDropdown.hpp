@@ -0,0 +1,23 @@
+#pragma once
+
+#include "UnityEngine/Behaviour.hpp"
+#include "UnityEngine/UI/Button.hpp"
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HMUI {
+    class SimpleTextDropdown : public UnityEngine::MonoBehaviour {
+    public:
+        UnityEngine::UI::Button* button = nullptr;
+        int selectedIndex = 0;
+        /// @brief Stands in for the managed list, see HeadlessBackend::setDropdownTexts
+        std::vector<std::string> texts;
+        /// @brief Stands in for didSelectCellWithIdxEvent
+        std::function<void(std::string_view)> onValueChanged;
+
+        void SelectCellWithIdx(int index) { selectedIndex = index; }
+    };
+}
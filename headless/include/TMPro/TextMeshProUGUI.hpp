@@ -0,0 +1,27 @@
+#pragma once
+
+#include "UnityEngine/Behaviour.hpp"
+#include "UnityEngine/Color.hpp"
+#include "UnityEngine/RectTransform.hpp"
+
+#include <string>
+
+namespace TMPro {
+    class TextMeshProUGUI : public UnityEngine::MonoBehaviour {
+    public:
+        /// @brief Stands in for the managed string, see HeadlessBackend::setText
+        std::string text;
+        UnityEngine::Color color = UnityEngine::Color::get_white();
+        float fontSize = 4;
+        bool richText = false;
+
+        [[nodiscard]] UnityEngine::RectTransform* get_rectTransform() const {
+            return static_cast<UnityEngine::RectTransform*>(get_transform());
+        }
+
+        [[nodiscard]] float get_fontSize() const { return fontSize; }
+        void set_fontSize(float value) { fontSize = value; }
+        [[nodiscard]] UnityEngine::Color get_color() const { return color; }
+        void set_richText(bool value) { richText = value; }
+    };
+}
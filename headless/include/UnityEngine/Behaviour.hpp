@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Component.hpp"
+
+namespace UnityEngine {
+    class Behaviour : public Component {
+    public:
+        bool enabled = true;
+
+        [[nodiscard]] bool get_enabled() const {
+            return enabled;
+        }
+
+        void set_enabled(bool value) {
+            enabled = value;
+        }
+    };
+
+    class MonoBehaviour : public Behaviour {};
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace UnityEngine {
+    struct Color {
+        float r = 0;
+        float g = 0;
+        float b = 0;
+        float a = 0;
+
+        constexpr Color() = default;
+        constexpr Color(float r, float g, float b, float a = 1) : r(r), g(g), b(b), a(a) {}
+
+        constexpr bool operator==(Color const&) const = default;
+
+        static constexpr Color get_white() {
+            return {1, 1, 1, 1};
+        }
+    };
+}
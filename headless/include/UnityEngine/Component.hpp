@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Object.hpp"
+
+namespace UnityEngine {
+    class GameObject;
+    class Transform;
+
+    class Component : public Object {
+    public:
+        GameObject* gameObject = nullptr;
+
+        [[nodiscard]] GameObject* get_gameObject() const {
+            return gameObject;
+        }
+
+        [[nodiscard]] Transform* get_transform() const;
+
+        template<class T>
+        T GetComponent() const;
+
+        template<class T>
+        T GetComponentInChildren() const;
+    };
+}
+
+#include "GameObject.hpp"
+
+namespace UnityEngine {
+    inline Transform* Component::get_transform() const {
+        return gameObject->get_transform();
+    }
+
+    template<class T>
+    T Component::GetComponent() const {
+        return gameObject->template GetComponent<T>();
+    }
+
+    template<class T>
+    T Component::GetComponentInChildren() const {
+        return gameObject->template GetComponentInChildren<T>();
+    }
+}
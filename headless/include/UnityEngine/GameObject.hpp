@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Object.hpp"
+
+#include <vector>
+
+namespace UnityEngine {
+    class Component;
+    class Transform;
+
+    class GameObject : public Object {
+    public:
+        /// @brief Every component on this object, including its transform
+        std::vector<Component*> components;
+        Transform* transform = nullptr;
+        bool active = true;
+
+        [[nodiscard]] Transform* get_transform() const {
+            return transform;
+        }
+
+        void SetActive(bool value) {
+            active = value;
+        }
+
+        [[nodiscard]] bool get_activeSelf() const {
+            return active;
+        }
+
+        template<class T>
+        T GetComponent() const;
+
+        template<class T>
+        T GetComponentInChildren() const;
+    };
+}
+
+#include "Transform.hpp"
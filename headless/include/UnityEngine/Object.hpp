@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+
+// Headless stand-in for the Unity type of the same name, see shared/backend/HeadlessBackend.hpp.
+// Only implements what QUC uses, with the same names as the codegen headers.
+
+struct Il2CppObject;
+
+namespace UnityEngine {
+    class Object {
+    public:
+        Object() = default;
+        Object(Object const&) = delete;
+        virtual ~Object() = default;
+
+        /// @brief Points at the object while it is alive, nullptr once it was destroyed
+        void* m_CachedPtr = this;
+        std::string name;
+
+        static void DontDestroyOnLoad(Object*) {}
+    };
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Transform.hpp"
+#include "Vector2.hpp"
+
+namespace UnityEngine {
+    class RectTransform : public Transform {
+    public:
+        Vector2 anchoredPosition;
+        Vector2 sizeDelta;
+        Vector2 anchorMin;
+        Vector2 anchorMax;
+
+        [[nodiscard]] Vector2 get_anchoredPosition() const { return anchoredPosition; }
+        void set_anchoredPosition(Vector2 value) { anchoredPosition = value; }
+        [[nodiscard]] Vector2 get_sizeDelta() const { return sizeDelta; }
+        void set_sizeDelta(Vector2 value) { sizeDelta = value; }
+        void set_anchorMin(Vector2 value) { anchorMin = value; }
+        void set_anchorMax(Vector2 value) { anchorMax = value; }
+    };
+}
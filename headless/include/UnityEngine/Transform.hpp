@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Component.hpp"
+#include "Vector2.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace UnityEngine {
+    class Transform : public Component {
+    public:
+        Transform* parent = nullptr;
+        std::vector<Transform*> children;
+        /// @brief x and y of the local scale, UI isn't scaled along z
+        Vector2 localScale{1.0f, 1.0f};
+
+        [[nodiscard]] Transform* get_parent() const {
+            return parent;
+        }
+
+        void SetParent(Transform* newParent, bool) {
+            if (parent) {
+                std::erase(parent->children, this);
+            }
+            parent = newParent;
+            if (parent) {
+                parent->children.push_back(this);
+            }
+        }
+
+        [[nodiscard]] int GetChildCount() const {
+            return static_cast<int>(children.size());
+        }
+
+        [[nodiscard]] Transform* GetChild(int index) const {
+            return children[index];
+        }
+
+        [[nodiscard]] int GetSiblingIndex() const {
+            if (!parent) return 0;
+            auto& siblings = parent->children;
+            return static_cast<int>(std::find(siblings.begin(), siblings.end(), this) - siblings.begin());
+        }
+
+        void SetSiblingIndex(int index) {
+            if (!parent) return;
+            auto& siblings = parent->children;
+            std::erase(siblings, this);
+            index = std::clamp(index, 0, static_cast<int>(siblings.size()));
+            siblings.insert(siblings.begin() + index, this);
+        }
+
+        /// @brief Direct child called name
+        [[nodiscard]] Transform* Find(std::string_view childName) const {
+            for (auto child : children) {
+                if (child->get_gameObject()->name == childName) return child;
+            }
+            return nullptr;
+        }
+    };
+}
+
+namespace UnityEngine {
+    template<class T>
+    T GameObject::GetComponent() const {
+        for (auto component : components) {
+            if (auto match = dynamic_cast<T>(component)) return match;
+        }
+        return nullptr;
+    }
+
+    template<class T>
+    T GameObject::GetComponentInChildren() const {
+        if (auto match = GetComponent<T>()) return match;
+        for (auto child : transform->children) {
+            if (auto match = child->get_gameObject()->template GetComponentInChildren<T>()) return match;
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "UnityEngine/Behaviour.hpp"
+#include "Image.hpp"
+
+#include <functional>
+
+namespace UnityEngine::UI {
+    class Button : public MonoBehaviour {
+    public:
+        bool interactable = true;
+        Image* image = nullptr;
+        /// @brief Stands in for onClick, see HeadlessBackend::click
+        std::function<void()> onClick;
+
+        void set_interactable(bool value) { interactable = value; }
+        [[nodiscard]] bool get_interactable() const { return interactable; }
+        void set_image(Image* value) { image = value; }
+    };
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "UnityEngine/Behaviour.hpp"
+
+namespace UnityEngine::UI {
+    class LayoutGroup : public MonoBehaviour {};
+}
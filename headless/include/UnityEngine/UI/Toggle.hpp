@@ -0,0 +1,19 @@
+#pragma once
+
+#include "UnityEngine/Behaviour.hpp"
+
+#include <functional>
+
+namespace UnityEngine::UI {
+    class Toggle : public MonoBehaviour {
+    public:
+        bool isOn = false;
+        bool interactable = true;
+        /// @brief Stands in for onValueChanged
+        std::function<void(bool)> onValueChanged;
+
+        void set_isOn(bool value) { isOn = value; }
+        [[nodiscard]] bool get_isOn() const { return isOn; }
+        void set_interactable(bool value) { interactable = value; }
+    };
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "LayoutGroup.hpp"
+
+namespace UnityEngine::UI {
+    class VerticalLayoutGroup : public LayoutGroup {};
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "UnityEngine/Color.hpp"
+
+namespace Sombrero {
+    struct FastColor : UnityEngine::Color {
+        using UnityEngine::Color::Color;
+        constexpr FastColor(UnityEngine::Color const& color) : UnityEngine::Color(color) {}
+    };
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "UnityEngine/Vector2.hpp"
+
+namespace Sombrero {
+    struct FastVector2 : UnityEngine::Vector2 {
+        using UnityEngine::Vector2::Vector2;
+        constexpr FastVector2(UnityEngine::Vector2 const& vector) : UnityEngine::Vector2(vector) {}
+    };
+}
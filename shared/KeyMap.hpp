@@ -0,0 +1,373 @@
+#pragma once
+
+#include "key.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory_resource>
+#include <utility>
+#include <functional>
+
+namespace QUC {
+    /// @brief Open addressing (Robin Hood) hash map from Key to V.
+    /// The bucket array only stores the hash and a pointer to the entry, which keeps probing
+    /// inside a couple of cache lines. Entries are allocated from chunks owned by the map, so
+    /// unlike a flat map, references to values stay valid until that value is erased.
+    /// Nothing is allocated until the first insertion. The first allocation holds both the bucket array and
+    /// the first entries, so a map that was reserved for its size allocates once.
+    /// All memory comes from the given memory resource, and values constructible from a memory resource are constructed with it.
+    template<typename V>
+    struct KeyMap {
+        KeyMap() = default;
+        explicit KeyMap(std::pmr::memory_resource* resource) : resource(resource) {}
+        KeyMap(KeyMap const&) = delete;
+
+        KeyMap(KeyMap&& other) noexcept {
+            swap(other);
+        }
+
+        KeyMap& operator=(KeyMap&& other) noexcept {
+            if (this != &other) {
+                KeyMap(std::move(other)).swap(*this);
+            }
+            return *this;
+        }
+
+        ~KeyMap() {
+            release();
+        }
+
+        void swap(KeyMap& other) noexcept {
+            std::swap(buckets, other.buckets);
+            std::swap(mask, other.mask);
+            std::swap(count, other.count);
+            std::swap(resource, other.resource);
+            std::swap(chunks, other.chunks);
+            std::swap(chunkUsed, other.chunkUsed);
+            std::swap(freeList, other.freeList);
+            std::swap(bucketsInChunk, other.bucketsInChunk);
+        }
+
+        [[nodiscard]] std::pmr::memory_resource* getResource() const noexcept {
+            return resource;
+        }
+
+        [[nodiscard]] size_t size() const noexcept {
+            return count;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return count == 0;
+        }
+
+        /// @brief Makes room for n entries in an empty map with a single allocation, sized for exactly n entries.
+        /// A map that already allocated only grows its bucket array.
+        void reserve(size_t n) {
+            if (n == 0) return;
+            if (!buckets && !chunks) {
+                allocateFirst(capacityFor(n), n);
+            } else if (n * 8 > (mask + 1) * 7) {
+                rehash(capacityFor(n));
+            }
+        }
+
+        [[nodiscard]] V* find(Key const& key) noexcept {
+            auto idx = findIndex(key, hashOf(key));
+            if (idx == npos) return nullptr;
+            return &buckets[idx].node->value;
+        }
+
+        V& operator[](Key const& key) {
+            if constexpr (std::is_constructible_v<V, std::pmr::memory_resource*>) {
+                return *tryEmplace(key, resource).first;
+            } else {
+                return *tryEmplace(key).first;
+            }
+        }
+
+        /// @brief Constructs the value of key from args, unless key is already in the map.
+        /// @return The value of key, and whether it was inserted
+        template<typename... Args>
+        std::pair<V*, bool> tryEmplace(Key const& key, Args&&... args) {
+            auto hash = hashOf(key);
+            auto idx = findIndex(key, hash);
+            if (idx != npos) return {&buckets[idx].node->value, false};
+
+            if (!buckets && !chunks) {
+                allocateFirst(minCapacity, minChunk);
+            } else if (!buckets || (count + 1) * 8 > (mask + 1) * 7) {
+                rehash(buckets ? (mask + 1) * 2 : minCapacity);
+            }
+
+            auto node = new (allocateNode()) Node{key, V(std::forward<Args>(args)...)};
+            insertBucket({hash, node});
+            count++;
+            return {&node->value, true};
+        }
+
+        bool erase(Key const& key) {
+            auto idx = findIndex(key, hashOf(key));
+            if (idx == npos) return false;
+
+            releaseNode(buckets[idx].node);
+            shiftBackward(idx);
+            count--;
+            return true;
+        }
+
+        /// @brief Destroys every value. The bucket array and entry chunks are kept for reuse.
+        void clear() {
+            if (count == 0) return;
+
+            for (size_t i = 0; i <= mask; i++) {
+                if (buckets[i].node) {
+                    releaseNode(buckets[i].node);
+                    buckets[i] = {};
+                }
+            }
+            count = 0;
+        }
+
+        /// @brief Destroys every value and gives all memory back to the memory resource.
+        void release() {
+            clear();
+            if (buckets && !bucketsInChunk) {
+                resource->deallocate(buckets, (mask + 1) * sizeof(Bucket), alignof(Bucket));
+            }
+            buckets = nullptr;
+            mask = 0;
+            bucketsInChunk = false;
+            freeChunks();
+        }
+
+        /// @brief Erases every entry for which pred(Key const&, V&) returns true.
+        /// pred is called exactly once per entry.
+        /// @return The amount of erased entries
+        template<typename F>
+        size_t eraseIf(F&& pred) {
+            if (count == 0) return 0;
+
+            // Start after an empty bucket (the load factor guarantees one). Entries never shift
+            // backwards over it, so every entry is checked exactly once even while erasing.
+            size_t start = 0;
+            while (buckets[start].node) {
+                start = (start + 1) & mask;
+            }
+
+            size_t erased = 0;
+            size_t idx = (start + 1) & mask;
+            for (size_t remaining = mask; remaining > 0;) {
+                auto node = buckets[idx].node;
+                if (node && pred(std::as_const(node->key), node->value)) {
+                    releaseNode(node);
+                    shiftBackward(idx);
+                    count--;
+                    erased++;
+                    // idx now holds the next entry of the probe sequence, check it as well
+                    continue;
+                }
+                idx = (idx + 1) & mask;
+                remaining--;
+            }
+            return erased;
+        }
+
+        /// @brief Calls f(Key const&, V&) for each entry. The map must not be modified while iterating.
+        template<typename F>
+        void forEach(F&& f) {
+            if (count == 0) return;
+
+            for (size_t i = 0; i <= mask; i++) {
+                if (auto node = buckets[i].node) {
+                    f(std::as_const(node->key), node->value);
+                }
+            }
+        }
+
+    private:
+        struct Node {
+            Key key;
+            V value;
+        };
+
+        struct Bucket {
+            size_t hash;
+            Node* node;
+        };
+
+        union NodeStorage {
+            NodeStorage* next;
+            alignas(Node) std::byte bytes[sizeof(Node)];
+        };
+
+        /// @brief Entries, and for the first chunk also the first bucket array behind them
+        struct Chunk {
+            Chunk* next;
+            size_t capacity;
+            size_t bytes;
+
+            NodeStorage* nodes() noexcept {
+                return reinterpret_cast<NodeStorage*>(reinterpret_cast<std::byte*>(this) + nodesOffset);
+            }
+        };
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+        // std::hash<Key> is a bijection on 64 bit ids, so equal hashes mean equal keys
+        static constexpr bool hashIsIdentity = sizeof(size_t) == sizeof(uint64_t);
+        static constexpr size_t minCapacity = 8;
+        /// @brief Bucket array of a map that was reserved for a single entry, there always has to be an empty bucket
+        static constexpr size_t smallestCapacity = 2;
+        static constexpr size_t minChunk = 4;
+        static constexpr size_t maxChunk = 256;
+        static constexpr size_t chunkAlign = alignof(NodeStorage) > alignof(Chunk) ? alignof(NodeStorage) : alignof(Chunk);
+        static constexpr size_t nodesOffset = (sizeof(Chunk) + alignof(NodeStorage) - 1) / alignof(NodeStorage) * alignof(NodeStorage);
+
+        static constexpr size_t chunkBytes(size_t capacity) noexcept {
+            return nodesOffset + capacity * sizeof(NodeStorage);
+        }
+
+        /// @brief The smallest bucket array holding n entries within the load factor
+        static constexpr size_t capacityFor(size_t n) noexcept {
+            size_t capacity = smallestCapacity;
+            while (n * 8 > capacity * 7) capacity *= 2;
+            return capacity;
+        }
+
+        static size_t hashOf(Key const& key) noexcept {
+            return std::hash<Key>()(key);
+        }
+
+        [[nodiscard]] size_t distance(size_t idx, size_t hash) const noexcept {
+            return (idx - (hash & mask)) & mask;
+        }
+
+        [[nodiscard]] size_t findIndex(Key const& key, size_t hash) const noexcept {
+            if (count == 0) return npos;
+
+            size_t idx = hash & mask;
+            for (size_t dist = 0;; dist++) {
+                auto const& bucket = buckets[idx];
+                if (!bucket.node || distance(idx, bucket.hash) < dist) return npos;
+                if (bucket.hash == hash && (hashIsIdentity || bucket.node->key == key)) return idx;
+                idx = (idx + 1) & mask;
+            }
+        }
+
+        void insertBucket(Bucket entry) noexcept {
+            size_t idx = entry.hash & mask;
+            for (size_t dist = 0;; dist++) {
+                auto& bucket = buckets[idx];
+                if (!bucket.node) {
+                    bucket = entry;
+                    return;
+                }
+
+                // take from the rich, entries closer to their ideal slot move along
+                auto existingDist = distance(idx, bucket.hash);
+                if (existingDist < dist) {
+                    std::swap(entry, bucket);
+                    dist = existingDist;
+                }
+                idx = (idx + 1) & mask;
+            }
+        }
+
+        // backward shift, keeps probe sequences short without tombstones
+        void shiftBackward(size_t idx) noexcept {
+            auto next = (idx + 1) & mask;
+            while (buckets[next].node && distance(next, buckets[next].hash) != 0) {
+                buckets[idx] = buckets[next];
+                idx = next;
+                next = (next + 1) & mask;
+            }
+            buckets[idx] = {};
+        }
+
+        void rehash(size_t capacity) {
+            auto oldBuckets = buckets;
+            auto oldCapacity = buckets ? mask + 1 : 0;
+            auto oldInChunk = std::exchange(bucketsInChunk, false);
+
+            buckets = static_cast<Bucket*>(resource->allocate(capacity * sizeof(Bucket), alignof(Bucket)));
+            std::fill_n(buckets, capacity, Bucket{});
+            mask = capacity - 1;
+
+            for (size_t i = 0; i < oldCapacity; i++) {
+                if (oldBuckets[i].node) insertBucket(oldBuckets[i]);
+            }
+            if (oldBuckets && oldInChunk) {
+                // shares its allocation with entries, so it becomes room for more of them
+                auto storage = reinterpret_cast<NodeStorage*>(oldBuckets);
+                for (size_t i = 0; i < oldCapacity * sizeof(Bucket) / sizeof(NodeStorage); i++) {
+                    storage[i].next = freeList;
+                    freeList = &storage[i];
+                }
+            } else if (oldBuckets) {
+                resource->deallocate(oldBuckets, oldCapacity * sizeof(Bucket), alignof(Bucket));
+            }
+        }
+
+        /// @brief Allocates the bucket array and the first chunk of entries at once
+        void allocateFirst(size_t capacity, size_t nodes) {
+            // buckets behind the nodes are aligned as well
+            static_assert(alignof(Bucket) <= alignof(NodeStorage) && sizeof(NodeStorage) % alignof(Bucket) == 0);
+            auto bytes = chunkBytes(nodes) + capacity * sizeof(Bucket);
+            auto memory = resource->allocate(bytes, chunkAlign);
+            chunks = new (memory) Chunk{nullptr, nodes, bytes};
+            chunkUsed = 0;
+
+            buckets = reinterpret_cast<Bucket*>(static_cast<std::byte*>(memory) + chunkBytes(nodes));
+            std::fill_n(buckets, capacity, Bucket{});
+            mask = capacity - 1;
+            bucketsInChunk = true;
+        }
+
+        void* allocateNode() {
+            if (freeList) {
+                auto storage = freeList;
+                freeList = storage->next;
+                return storage;
+            }
+
+            if (!chunks || chunkUsed == chunks->capacity) {
+                // small maps stay small, big maps get few large chunks
+                size_t capacity = chunks ? std::min(chunks->capacity * 2, maxChunk) : minChunk;
+                auto memory = resource->allocate(chunkBytes(capacity), chunkAlign);
+                chunks = new (memory) Chunk{chunks, capacity, chunkBytes(capacity)};
+                chunkUsed = 0;
+            }
+
+            return &chunks->nodes()[chunkUsed++];
+        }
+
+        void releaseNode(Node* node) noexcept {
+            node->~Node();
+            auto storage = reinterpret_cast<NodeStorage*>(node);
+            storage->next = freeList;
+            freeList = storage;
+        }
+
+        void freeChunks() noexcept {
+            while (chunks) {
+                auto next = chunks->next;
+                resource->deallocate(chunks, chunks->bytes, chunkAlign);
+                chunks = next;
+            }
+            chunkUsed = 0;
+            freeList = nullptr;
+        }
+
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+        Bucket* buckets = nullptr;
+        size_t mask = 0;
+        size_t count = 0;
+
+        Chunk* chunks = nullptr;
+        size_t chunkUsed = 0;
+        NodeStorage* freeList = nullptr;
+        /// @brief The bucket array lives in the first chunk, see allocateFirst
+        bool bucketsInChunk = false;
+    };
+}
@@ -14,8 +14,8 @@ namespace QUC {
         struct Container {
             std::tuple<TArgs...> children;
             const Key key;
-            Container(TArgs... args) : children(args...) {}
-            Container(std::tuple<TArgs...> args) : children(args) {}
+            Container(TArgs... args) : children(std::forward<TArgs>(args)...) {}
+            Container(std::tuple<TArgs...> args) : children(std::move(args)) {}
 
 
             [[nodiscard]] std::tuple<TArgs...> clone() const {
@@ -24,7 +24,7 @@ namespace QUC {
 
 
             void render(RenderContext& ctx, RenderContextChildData& data) {
-                QUC::detail::renderTuple(children, ctx);
+                QUC::detail::renderTuple(children, ctx, data);
             }
         };
 
@@ -34,18 +34,23 @@ namespace QUC {
         requires (renderable<Component>)
         struct VariableContainer
         {
-            const InnerList children;
+            /// @brief May be changed between renders, children are matched up by key
+            InnerList children;
             const Key key;
+            // changing children isn't a HeldData write, so the list has to be compared on every render
+            static constexpr bool alwaysRender = true;
 
             VariableContainer(InnerList const& children) : children(children) {}
+            VariableContainer(InnerList&& children) : children(std::move(children)) {}
 
             VariableContainer(std::initializer_list<Component> const children) : children(children) {}
 
             VariableContainer(std::span<Component> const children) : children(children) {}
 
+            /// @brief Children added since the last render are created, removed ones destroyed,
+            /// and moved ones reordered in Unity with as few sibling index changes as possible.
             void render(RenderContext& ctx, RenderContextChildData& data) {
-                // BEHOLD! MY BAD PRACTICE UNCONST INATOR
-                QUC::detail::renderDynamicList<Component>(*const_cast<InnerList*>(&children), ctx);
+                QUC::detail::renderKeyedList<Component>(children, ctx, data.getData<KeyedList>());
             }
         };
 
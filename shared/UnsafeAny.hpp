@@ -1,47 +1,136 @@
 #pragma once
 
-#include <malloc.h>
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 namespace QUC {
+    /// @brief Type erased storage for component state.
+    /// Values up to two pointers in size (most render data is a native pointer or two) are
+    /// stored inline without allocating, anything bigger is allocated from a memory resource.
+    /// The type is not checked on access unless asserts are enabled.
     struct UnsafeAny {
+        static constexpr size_t inlineSize = 2 * sizeof(void*);
+
+        template<typename T>
+        static constexpr bool storedInline = sizeof(T) <= inlineSize &&
+                                             alignof(T) <= alignof(void*) &&
+                                             std::is_nothrow_move_constructible_v<T>;
+
         UnsafeAny() = default;
         UnsafeAny(UnsafeAny const&) = delete;
 
+        UnsafeAny(UnsafeAny&& other) noexcept {
+            moveFrom(other);
+        }
+
+        UnsafeAny& operator=(UnsafeAny&& other) noexcept {
+            if (this != &other) {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
         template<typename T, typename... TArgs>
         T& make_any(TArgs&&... args) {
-            if (dtor != nullptr) {
-                dtor(data);
+            return make_any_with<T>(std::pmr::new_delete_resource(), std::forward<TArgs>(args)...);
+        }
+
+        /// @brief Same as make_any, but allocates values that don't fit inline from resource
+        template<typename T, typename... TArgs>
+        T& make_any_with(std::pmr::memory_resource* resource, TArgs&&... args) {
+            reset();
+            if constexpr (storedInline<T>) {
+                new (storage.buffer) T(std::forward<TArgs>(args)...);
+            } else {
+                void* memory = resource->allocate(sizeof(T), alignof(T));
+                try {
+                    new (memory) T(std::forward<TArgs>(args)...);
+                } catch (...) {
+                    resource->deallocate(memory, sizeof(T), alignof(T));
+                    throw;
+                }
+                storage.heap = {memory, resource};
             }
-            free(data);
-            data = new T(std::forward<TArgs>(args)...);
-            dtor = &destroy_data<T>;
+            manager = &manage<T>;
             return get_any<T>();
         }
 
         template<typename T>
         T& get_any() {
-            return *static_cast<T*>(data);
+            // The manager is unique per type, so it doubles as a type tag
+            assert(manager == &manage<T> && "UnsafeAny accessed with a different type than it holds");
+
+            if constexpr (storedInline<T>) {
+                return *std::launder(reinterpret_cast<T*>(storage.buffer));
+            } else {
+                return *static_cast<T*>(storage.heap.value);
+            }
+        }
+
+        [[nodiscard]] bool has_value() const noexcept {
+            return manager != nullptr;
         }
 
-        bool has_value() {
-            return data != nullptr;
+        void reset() noexcept {
+            if (manager != nullptr) {
+                manager(Operation::Destroy, *this, nullptr);
+                manager = nullptr;
+            }
         }
 
         ~UnsafeAny() {
-            if (dtor != nullptr)
-                dtor(data);
-            free(data);
+            reset();
         }
 
     private:
+        enum class Operation {
+            Destroy,
+            Move
+        };
+
+        using Manager = void(*)(Operation op, UnsafeAny& self, UnsafeAny* target);
 
         template<typename T>
-        static void destroy_data(void* ptr) {
-            delete reinterpret_cast<T*>(ptr);
+        static void manage(Operation op, UnsafeAny& self, UnsafeAny* target) {
+            if constexpr (storedInline<T>) {
+                auto value = std::launder(reinterpret_cast<T*>(self.storage.buffer));
+                if (op == Operation::Move) {
+                    new (target->storage.buffer) T(std::move(*value));
+                }
+                value->~T();
+            } else {
+                auto heap = self.storage.heap;
+                if (op == Operation::Move) {
+                    target->storage.heap = heap;
+                } else {
+                    static_cast<T*>(heap.value)->~T();
+                    heap.resource->deallocate(heap.value, sizeof(T), alignof(T));
+                }
+            }
         }
 
-        void* data = nullptr;
-        void(*dtor)(void*) = nullptr;
+        void moveFrom(UnsafeAny& other) noexcept {
+            if (other.manager == nullptr) return;
+
+            other.manager(Operation::Move, other, this);
+            manager = other.manager;
+            other.manager = nullptr;
+        }
+
+        struct HeapStorage {
+            void* value;
+            std::pmr::memory_resource* resource;
+        };
+
+        union Storage {
+            HeapStorage heap;
+            alignas(void*) std::byte buffer[inlineSize];
+        } storage{};
+        Manager manager = nullptr;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,466 @@
+#pragma once
+
+#include "context.hpp"
+#include "backend.hpp"
+#include "profiler.hpp"
+#include "function.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "UnityEngine/Vector2.hpp"
+#include "UnityEngine/Color.hpp"
+#include "UnityEngine/GameObject.hpp"
+#include "UnityEngine/Transform.hpp"
+#include "UnityEngine/RectTransform.hpp"
+
+#include "TMPro/TextMeshProUGUI.hpp"
+
+namespace QUC {
+    /// @brief How a tween moves from its start to its end over its duration, see https://easings.net
+    enum class Easing : uint8_t {
+        Linear,
+        InQuad,
+        OutQuad,
+        InOutQuad,
+        InCubic,
+        OutCubic,
+        InOutCubic,
+        InOutSine,
+        OutBack
+    };
+
+    /// @brief What a tween does once it reached its end
+    enum class Repeat : uint8_t {
+        /// @brief Stops at the end
+        Once,
+        /// @brief Starts over from the start
+        Loop,
+        /// @brief Goes back to the start, then forth again
+        PingPong
+    };
+
+    struct TweenOptions {
+        /// @brief Seconds from start to end
+        float duration = 0.25f;
+        Easing easing = Easing::Linear;
+        Repeat repeat = Repeat::Once;
+    };
+
+    namespace detail {
+        /// @brief Eased progress of t in [0, 1]
+        inline float ease(Easing easing, float t) noexcept {
+            switch (easing) {
+                case Easing::Linear:
+                    return t;
+                case Easing::InQuad:
+                    return t * t;
+                case Easing::OutQuad:
+                    return 1 - (1 - t) * (1 - t);
+                case Easing::InOutQuad:
+                    return t < 0.5f ? 2 * t * t : 1 - 2 * (1 - t) * (1 - t);
+                case Easing::InCubic:
+                    return t * t * t;
+                case Easing::OutCubic:
+                    return 1 - (1 - t) * (1 - t) * (1 - t);
+                case Easing::InOutCubic:
+                    return t < 0.5f ? 4 * t * t * t : 1 - 4 * (1 - t) * (1 - t) * (1 - t);
+                case Easing::InOutSine:
+                    return 0.5f - 0.5f * std::cos(t * 3.14159265f);
+                case Easing::OutBack: {
+                    constexpr float overshoot = 1.70158f;
+                    float u = t - 1;
+                    return 1 + (overshoot + 1) * u * u * u + overshoot * u * u;
+                }
+            }
+            return t;
+        }
+
+        /// @brief Color of hue (in turns, wrapped to [0, 1)), saturation and value
+        inline UnityEngine::Color hsvToRgb(float hue, float saturation, float value, float alpha) noexcept {
+            float h = (hue - std::floor(hue)) * 6;
+            auto channel = [&](float n) {
+                float k = std::fmod(n + h, 6.0f);
+                return value - value * saturation * std::clamp(std::min(k, 4 - k), 0.0f, 1.0f);
+            };
+            return {channel(5), channel(3), channel(1), alpha};
+        }
+
+        inline void rgbToHsv(UnityEngine::Color color, float& hue, float& saturation, float& value) noexcept {
+            float max = std::max({color.r, color.g, color.b});
+            float min = std::min({color.r, color.g, color.b});
+            float range = max - min;
+
+            value = max;
+            saturation = max > 0 ? range / max : 0;
+            if (range <= 0) {
+                hue = 0;
+            } else if (max == color.r) {
+                hue = (color.g - color.b) / range;
+            } else if (max == color.g) {
+                hue = 2 + (color.b - color.r) / range;
+            } else {
+                hue = 4 + (color.r - color.g) / range;
+            }
+            hue /= 6;
+            if (hue < 0) hue += 1;
+        }
+    }
+
+    /// @brief A running tween of the Animator, cancelled when the handle is destroyed.
+    /// Keeping it in the render data of a component stops the tween once the component is unmounted.
+    struct Tween {
+        Tween() = default;
+        explicit Tween(uint32_t id) noexcept : id(id) {}
+
+        Tween(Tween const&) = delete;
+        Tween& operator=(Tween const&) = delete;
+
+        Tween(Tween&& other) noexcept : id(std::exchange(other.id, 0)) {}
+
+        Tween& operator=(Tween&& other) noexcept {
+            if (this != &other) {
+                cancel();
+                id = std::exchange(other.id, 0);
+            }
+            return *this;
+        }
+
+        ~Tween() {
+            cancel();
+        }
+
+        /// @brief Stops the tween where it is
+        inline void cancel() noexcept;
+
+        /// @brief Whether the tween hasn't finished or been cancelled yet
+        [[nodiscard]] inline bool running() const noexcept;
+
+        /// @brief Lets the tween run to its end without a handle, loops never end
+        void detach() noexcept {
+            id = 0;
+        }
+
+    private:
+        uint32_t id = 0;
+    };
+
+    /// @brief Runs every tween of the UI from one place, once per frame on the main thread.
+    /// Tweens are stored as parallel arrays and advanced together: progress and values are computed in plain loops
+    /// over all of them, then only the native properties whose value changed since the last frame are set.
+    /// Tweens started while rendering belong to the view of the outermost component being rendered, others to the
+    /// object they animate. They pause while that view is hidden (inactive in the hierarchy), which costs one native
+    /// call per view and frame, and tweens of destroyed objects are dropped.
+    /// Frames are scheduled with Backend::scheduleOnMainThread while tweens are running or paused, at no cost otherwise.
+    /// Must only be used on the main thread.
+    struct Animator {
+        /// @brief Fades the color of text from from to to
+        [[nodiscard]] static Tween color(TMPro::TextMeshProUGUI* text, UnityEngine::Color from, UnityEngine::Color to, TweenOptions options = {}) {
+            return start(Property::Color, text, {from.r, from.g, from.b, from.a}, {to.r, to.g, to.b, to.a}, options);
+        }
+
+        /// @brief Fades only the alpha of text
+        [[nodiscard]] static Tween alpha(TMPro::TextMeshProUGUI* text, float from, float to, TweenOptions options = {}) {
+            return start(Property::Alpha, text, {from}, {to}, options);
+        }
+
+        /// @brief Shifts the hue of from by turns (1 is the full color wheel), keeping its saturation and value
+        [[nodiscard]] static Tween hue(TMPro::TextMeshProUGUI* text, UnityEngine::Color from, float turns, TweenOptions options = {}) {
+            float h, s, v;
+            detail::rgbToHsv(from, h, s, v);
+            return start(Property::Hue, text, {h, s, v, from.a}, {h + turns, s, v, from.a}, options);
+        }
+
+        /// @brief Moves the anchored position of rectTransform
+        [[nodiscard]] static Tween position(UnityEngine::RectTransform* rectTransform, UnityEngine::Vector2 from, UnityEngine::Vector2 to, TweenOptions options = {}) {
+            return start(Property::Position, rectTransform, {from.x, from.y}, {to.x, to.y}, options);
+        }
+
+        /// @brief Scales transform along x and y
+        [[nodiscard]] static Tween scale(UnityEngine::Transform* transform, UnityEngine::Vector2 from, UnityEngine::Vector2 to, TweenOptions options = {}) {
+            return start(Property::Scale, transform, {from.x, from.y}, {to.x, to.y}, options);
+        }
+
+        /// @brief Calls onValue with a number going from from to to, each frame it changed
+        [[nodiscard]] static Tween value(float from, float to, UniqueFunction<void(float)> onValue, TweenOptions options = {}) {
+            auto tween = start(Property::Value, nullptr, {from}, {to}, options);
+            callbacks.back() = std::move(onValue);
+            return tween;
+        }
+
+        /// @brief Advances every running tween by deltaTime seconds and sets what changed.
+        /// Called each frame while tweens are running, only call it yourself to drive tweens without frames.
+        static void tick(float deltaTime) {
+            QUC_PROFILE_SCOPE("Animator::tick");
+            size_t const count = ids.size();
+            std::vector<float>& eased = scratch;
+            eased.resize(count);
+
+            updateShown(count);
+            for (size_t i = 0; i < count; i++) {
+                elapsed[i] += deltaTime * shown[i];
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                float t = elapsed[i] / durations[i];
+                switch (repeats[i]) {
+                    case Repeat::Once:
+                        t = std::min(t, 1.0f);
+                        break;
+                    case Repeat::Loop:
+                        t -= std::floor(t);
+                        break;
+                    case Repeat::PingPong:
+                        t -= 2 * std::floor(t / 2);
+                        if (t > 1) t = 2 - t;
+                        break;
+                }
+                eased[i] = detail::ease(easings[i], t);
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                for (size_t lane = 0; lane < lanes; lane++) {
+                    size_t at = i * lanes + lane;
+                    values[at] = from[at] + (to[at] - from[at]) * eased[i];
+                }
+            }
+
+            // from + (to - from) isn't always to in floats, and some easings end next to 1, so ending tweens are set to their end
+            for (size_t i = 0; i < count; i++) {
+                if (repeats[i] == Repeat::Once && elapsed[i] >= durations[i]) {
+                    std::copy_n(&to[i * lanes], lanes, &values[i * lanes]);
+                }
+            }
+
+            // apply may start or cancel tweens, so nothing is held across it
+            for (size_t i = 0; i < count; i++) {
+                if (finished[i]) continue;
+
+                bool destroyed = (targets[i] && !targets[i]->m_CachedPtr) || (scopes[i] && !scopes[i]->m_CachedPtr);
+                if (destroyed) {
+                    finished[i] = 1;
+                    continue;
+                }
+                if (!shown[i]) continue;
+
+                size_t at = i * lanes;
+                if (!std::equal(&values[at], &values[at] + lanes, &written[at])) {
+                    std::copy_n(&values[at], lanes, &written[at]);
+                    apply(i);
+                }
+
+                if (repeats[i] == Repeat::Once && elapsed[i] >= durations[i]) {
+                    finished[i] = 1;
+                }
+            }
+
+            for (size_t i = ids.size(); i-- > 0;) {
+                if (finished[i]) remove(i);
+            }
+        }
+
+        /// @brief Amount of running tweens
+        [[nodiscard]] static size_t active() noexcept {
+            return ids.size() - std::count(finished.begin(), finished.end(), 1);
+        }
+
+        /// @brief Stops every tween
+        static void clear() {
+            std::fill(finished.begin(), finished.end(), 1);
+        }
+
+    private:
+        friend struct Tween;
+
+        enum class Property : uint8_t {
+            Color,
+            Alpha,
+            Hue,
+            Position,
+            Scale,
+            Value
+        };
+
+        /// @brief Floats per tween in from, to, values and written
+        static constexpr size_t lanes = 4;
+
+        static Tween start(Property property, UnityEngine::Component* target, std::array<float, lanes> first, std::array<float, lanes> last, TweenOptions const& options) {
+            uint32_t id = ++nextId;
+            // 0 is the empty handle
+            if (id == 0) id = ++nextId;
+
+            ids.push_back(id);
+            properties.push_back(property);
+            targets.push_back(target);
+            scopes.push_back(scopeOf(target));
+            elapsed.push_back(0);
+            durations.push_back(std::max(options.duration, std::numeric_limits<float>::epsilon()));
+            easings.push_back(options.easing);
+            repeats.push_back(options.repeat);
+            shown.push_back(1);
+            finished.push_back(0);
+            callbacks.emplace_back();
+
+            from.insert(from.end(), first.begin(), first.end());
+            to.insert(to.end(), last.begin(), last.end());
+            values.insert(values.end(), first.begin(), first.end());
+            // never equal to a value, so the first frame sets it
+            written.insert(written.end(), lanes, std::numeric_limits<float>::quiet_NaN());
+
+            scheduleTick();
+            return Tween(id);
+        }
+
+        /// @brief The view of the outermost component being rendered, or else the object of target
+        static UnityEngine::GameObject* scopeOf(UnityEngine::Component* target) {
+            if (auto frame = detail::DirtyTracker::current) {
+                while (frame->parent) {
+                    frame = frame->parent;
+                }
+                return frame->ctx->parentTransform.get_gameObject();
+            }
+            return target ? target->get_gameObject() : nullptr;
+        }
+
+        /// @brief Sets shown to whether the view of each tween is active, asking once per view
+        static void updateShown(size_t count) {
+            activeScopes.clear();
+            for (size_t i = 0; i < count; i++) {
+                auto scope = scopes[i];
+                if (!scope) {
+                    shown[i] = 1;
+                    continue;
+                }
+
+                auto known = std::find_if(activeScopes.begin(), activeScopes.end(), [scope](auto const& entry) { return entry.first == scope; });
+                if (known == activeScopes.end()) {
+                    bool active = scope->m_CachedPtr && QUC_NATIVE_CALL(Backend::isActive(scope));
+                    known = activeScopes.insert(activeScopes.end(), {scope, active});
+                }
+                shown[i] = known->second ? 1 : 0;
+            }
+        }
+
+        static void apply(size_t i) {
+            float const* value = &values[i * lanes];
+            switch (properties[i]) {
+                case Property::Color:
+                    QUC_NATIVE_CALL(Backend::setColor(static_cast<TMPro::TextMeshProUGUI*>(targets[i]), {value[0], value[1], value[2], value[3]}));
+                    break;
+                case Property::Alpha:
+                    QUC_NATIVE_CALL(Backend::setAlpha(static_cast<TMPro::TextMeshProUGUI*>(targets[i]), value[0]));
+                    break;
+                case Property::Hue:
+                    QUC_NATIVE_CALL(Backend::setColor(static_cast<TMPro::TextMeshProUGUI*>(targets[i]), detail::hsvToRgb(value[0], value[1], value[2], value[3])));
+                    break;
+                case Property::Position:
+                    QUC_NATIVE_CALL(Backend::setAnchoredPosition(static_cast<UnityEngine::RectTransform*>(targets[i]), {value[0], value[1]}));
+                    break;
+                case Property::Scale:
+                    QUC_NATIVE_CALL(Backend::setScale(static_cast<UnityEngine::Transform*>(targets[i]), {value[0], value[1]}));
+                    break;
+                case Property::Value:
+                    // held outside of the array while called, it may start tweens and move the array
+                    if (auto callback = std::move(callbacks[i])) {
+                        callback(value[0]);
+                        callbacks[i] = std::move(callback);
+                    }
+                    break;
+            }
+        }
+
+        /// @brief Moves the last tween into i
+        static void remove(size_t i) {
+            size_t last = ids.size() - 1;
+            auto removeAt = [i, last](auto& array) {
+                array[i] = std::move(array[last]);
+                array.pop_back();
+            };
+            removeAt(ids);
+            removeAt(properties);
+            removeAt(targets);
+            removeAt(scopes);
+            removeAt(elapsed);
+            removeAt(durations);
+            removeAt(easings);
+            removeAt(repeats);
+            removeAt(shown);
+            removeAt(finished);
+            removeAt(callbacks);
+
+            for (auto array : {&from, &to, &values, &written}) {
+                std::copy_n(array->begin() + last * lanes, lanes, array->begin() + i * lanes);
+                array->resize(last * lanes);
+            }
+        }
+
+        static void scheduleTick() {
+            if (tickScheduled) return;
+            tickScheduled = true;
+            Backend::scheduleOnMainThread([] {
+                tickScheduled = false;
+                tick(Backend::deltaTime());
+                if (!ids.empty()) scheduleTick();
+            });
+        }
+
+        static std::vector<uint32_t>::iterator find(uint32_t id) noexcept {
+            return std::find(ids.begin(), ids.end(), id);
+        }
+
+        static void cancel(uint32_t id) noexcept {
+            // removed on the next frame, cancelling may happen while ticking
+            if (auto it = find(id); it != ids.end()) {
+                finished[it - ids.begin()] = 1;
+            }
+        }
+
+        static bool running(uint32_t id) noexcept {
+            auto it = find(id);
+            return it != ids.end() && !finished[it - ids.begin()];
+        }
+
+        inline static uint32_t nextId = 0;
+        inline static bool tickScheduled = false;
+
+        // one entry per tween
+        inline static std::vector<uint32_t> ids;
+        inline static std::vector<Property> properties;
+        inline static std::vector<UnityEngine::Component*> targets;
+        inline static std::vector<UnityEngine::GameObject*> scopes;
+        inline static std::vector<float> elapsed;
+        inline static std::vector<float> durations;
+        inline static std::vector<Easing> easings;
+        inline static std::vector<Repeat> repeats;
+        /// @brief 1 while the view of the tween is active, multiplies the time that passes
+        inline static std::vector<float> shown;
+        inline static std::vector<uint8_t> finished;
+        /// @brief Only set for Property::Value
+        inline static std::vector<UniqueFunction<void(float)>> callbacks;
+
+        // lanes entries per tween
+        inline static std::vector<float> from;
+        inline static std::vector<float> to;
+        inline static std::vector<float> values;
+        /// @brief Last values set on the native object
+        inline static std::vector<float> written;
+
+        inline static std::vector<float> scratch;
+        inline static std::vector<std::pair<UnityEngine::GameObject*, bool>> activeScopes;
+    };
+
+    void Tween::cancel() noexcept {
+        if (id != 0) {
+            Animator::cancel(std::exchange(id, 0));
+        }
+    }
+
+    bool Tween::running() const noexcept {
+        return id != 0 && Animator::running(id);
+    }
+}
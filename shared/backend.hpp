@@ -0,0 +1,70 @@
+#pragma once
+
+/// Native operations of the components, behind a backend picked at compile time.
+/// By default QUC talks to the game through QuestUI and il2cpp. Defining QUC_HEADLESS switches to an
+/// in-memory backend instead, so the render and diff logic can be built, tested and measured on a plain
+/// Linux host (see the QUC_HEADLESS option in CMakeLists.txt).
+
+#include <concepts>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#ifdef QUC_HEADLESS
+#include "backend/HeadlessBackend.hpp"
+#else
+#include "backend/QuestUIBackend.hpp"
+#endif
+
+namespace QUC {
+    /// @brief What a backend has to provide. Every operation is a static function.
+    template<typename B>
+    concept native_backend = requires(UnityEngine::Transform* parent, UnityEngine::GameObject* object, std::string_view str,
+                                      UnityEngine::Vector2 vector, std::optional<UnityEngine::Vector2> optionalVector,
+                                      std::u16string_view chars, TMPro::TextMeshProUGUI* text, UnityEngine::UI::Button* button,
+                                      UnityEngine::UI::Toggle* toggle, HMUI::SimpleTextDropdown* dropdown,
+                                      UnityEngine::Behaviour* behaviour, UnityEngine::Color color, UnityEngine::RectTransform* rectTransform, float value,
+                                      std::function<void()> onClick, std::function<void(bool)> onValueChanged,
+                                      std::span<std::string const> texts, std::function<void(std::string_view)> onSelected) {
+        typename B::Strings;
+
+        {B::createObject(str)} -> std::same_as<UnityEngine::GameObject*>;
+        {B::destroy(object)};
+        {B::scheduleOnMainThread(onClick)};
+        {B::deltaTime()} -> std::same_as<float>;
+        {B::isActive(object)} -> std::same_as<bool>;
+
+        {B::createText(parent, str, true, vector, vector)} -> std::same_as<TMPro::TextMeshProUGUI*>;
+        {B::createButton(parent, str, str, optionalVector, optionalVector, onClick)} -> std::same_as<UnityEngine::UI::Button*>;
+        {B::createToggle(parent, str, true, optionalVector, onValueChanged)} -> std::same_as<UnityEngine::UI::Toggle*>;
+        {B::createVerticalLayoutGroup(parent)} -> std::same_as<UnityEngine::UI::VerticalLayoutGroup*>;
+        {B::createHorizontalLayoutGroup(parent)} -> std::same_as<UnityEngine::UI::HorizontalLayoutGroup*>;
+        {B::createDropdown(parent, str, str, texts, onSelected)} -> std::same_as<HMUI::SimpleTextDropdown*>;
+
+        {B::setText(text, str)};
+        {B::setCharArray(text, chars)};
+        {B::getText(text)} -> std::same_as<std::string>;
+        {B::setColor(text, color)};
+        {B::setAlpha(text, value)};
+        {B::setAnchoredPosition(rectTransform, vector)};
+        {B::setScale(parent, vector)};
+        {B::setEnabled(behaviour, true)};
+        {B::setOnClick(button, onClick)};
+        {B::setOnValueChanged(toggle, onValueChanged)};
+        {B::setDropdownTexts(dropdown, texts)};
+        {B::findChild(parent, str)} -> std::same_as<UnityEngine::Transform*>;
+    };
+
+#ifdef QUC_HEADLESS
+    using Backend = backend::HeadlessBackend;
+#else
+    using Backend = backend::QuestUIBackend;
+#endif
+
+    static_assert(native_backend<Backend>);
+
+    /// @brief Cache of the strings the backend hands to the game, see ManagedStringCache
+    using ManagedStrings = Backend::Strings;
+}
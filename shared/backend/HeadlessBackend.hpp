@@ -0,0 +1,415 @@
+#pragma once
+
+// Stand-ins for the Unity types, found in headless/include
+#include "UnityEngine/Object.hpp"
+#include "UnityEngine/GameObject.hpp"
+#include "UnityEngine/Transform.hpp"
+#include "UnityEngine/RectTransform.hpp"
+#include "UnityEngine/Behaviour.hpp"
+#include "UnityEngine/Vector2.hpp"
+#include "UnityEngine/Color.hpp"
+#include "UnityEngine/UI/Button.hpp"
+#include "UnityEngine/UI/Toggle.hpp"
+#include "UnityEngine/UI/VerticalLayoutGroup.hpp"
+#include "UnityEngine/UI/HorizontalLayoutGroup.hpp"
+#include "TMPro/TextMeshProUGUI.hpp"
+#include "HMUI/SimpleTextDropdown.hpp"
+
+#include "../strings.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef CRASH_UNLESS
+#define CRASH_UNLESS(expr) ::QUC::backend::HeadlessBackend::crashUnless((expr), #expr, __FILE__, __LINE__)
+#endif
+
+namespace QUC::backend {
+    /// @brief Stands in for managed strings, so ManagedStringCache can be measured off the Quest
+    struct HeadlessStrings {
+        using String = std::unique_ptr<std::string>;
+
+        static String create(std::string_view value) {
+            return std::make_unique<std::string>(value);
+        }
+
+        static std::string const& get(String const& string) noexcept {
+            return *string;
+        }
+
+        static void release(String& string) {
+            string.reset();
+        }
+    };
+
+    /// @brief Keeps the object tree in memory instead of talking to the game, and records every operation.
+    /// Objects behave like their Unity counterparts as far as QUC is concerned: they have a name, a parent,
+    /// ordered children and components, and are dead once destroyed.
+    /// Destroyed objects are only freed by reset(), so pointers to them stay safe to check.
+    /// Must only be used from one thread, except for scheduleOnMainThread.
+    struct HeadlessBackend {
+        enum class Op : uint8_t {
+            CreateObject,
+            CreateText,
+            CreateButton,
+            CreateToggle,
+            CreateLayout,
+            CreateDropdown,
+            Destroy,
+            SetText,
+            SetCharArray,
+            SetColor,
+            SetAlpha,
+            SetPosition,
+            SetScale,
+            SetEnabled,
+            SetOnClick,
+            SetDropdownTexts,
+            FindChild,
+            Count
+        };
+
+        using Strings = ManagedStringCache<HeadlessStrings>;
+
+        struct Record {
+            Op op;
+            UnityEngine::Object const* target;
+            /// @brief Text or name passed to the operation, if any
+            std::string value;
+        };
+
+        static UnityEngine::GameObject* createObject(std::string_view name) {
+            auto object = newObject(name, nullptr);
+            record(Op::CreateObject, object, name);
+            return object;
+        }
+
+        static void destroy(UnityEngine::GameObject* object) {
+            if (!object || !object->m_CachedPtr) return;
+            record(Op::Destroy, object, object->name);
+
+            object->get_transform()->SetParent(nullptr, false);
+            kill(object);
+        }
+
+        static void scheduleOnMainThread(std::function<void()> task) {
+            std::lock_guard lock(tasksMutex);
+            tasks.push_back(std::move(task));
+        }
+
+        /// @brief Seconds since the last frame, see setDeltaTime
+        static float deltaTime() noexcept {
+            return frameTime;
+        }
+
+        /// @brief Whether object and all of its parents are active
+        static bool isActive(UnityEngine::GameObject* object) {
+            for (auto transform = object->get_transform(); transform; transform = transform->get_parent()) {
+                if (!transform->get_gameObject()->active) return false;
+            }
+            return true;
+        }
+
+        static TMPro::TextMeshProUGUI* createText(UnityEngine::Transform* parent, std::string_view text, bool italic, UnityEngine::Vector2 anchoredPosition, UnityEngine::Vector2 sizeDelta) {
+            auto object = newObject("QuestUIText", parent);
+            auto textComp = addComponent<TMPro::TextMeshProUGUI>(object);
+            textComp->text = italic ? "<i>" + std::string(text) + "</i>" : std::string(text);
+
+            auto rectTransform = textComp->get_rectTransform();
+            rectTransform->anchoredPosition = anchoredPosition;
+            rectTransform->sizeDelta = sizeDelta;
+
+            record(Op::CreateText, textComp, text);
+            return textComp;
+        }
+
+        static UnityEngine::UI::Button* createButton(UnityEngine::Transform* parent, std::string_view text, std::string_view buttonTemplate,
+                                                     std::optional<UnityEngine::Vector2> anchoredPosition, std::optional<UnityEngine::Vector2> sizeDelta,
+                                                     std::function<void()> onClick) {
+            auto object = newObject(buttonTemplate, parent);
+            auto button = addComponent<UnityEngine::UI::Button>(object);
+            button->onClick = std::move(onClick);
+
+            auto rectTransform = static_cast<UnityEngine::RectTransform*>(object->get_transform());
+            if (anchoredPosition) rectTransform->anchoredPosition = *anchoredPosition;
+            if (sizeDelta) rectTransform->sizeDelta = *sizeDelta;
+
+            auto label = addComponent<TMPro::TextMeshProUGUI>(newObject("Text", object->get_transform()));
+            label->text = text;
+
+            record(Op::CreateButton, button, text);
+            return button;
+        }
+
+        /// @brief Like QuestUI, the toggle sits next to a "NameText" text, both inside an object of their own
+        static UnityEngine::UI::Toggle* createToggle(UnityEngine::Transform* parent, std::string_view text, bool value,
+                                                     std::optional<UnityEngine::Vector2> anchoredPosition, std::function<void(bool)> onValueChanged) {
+            auto root = newObject("Toggle", parent);
+            if (anchoredPosition) static_cast<UnityEngine::RectTransform*>(root->get_transform())->anchoredPosition = *anchoredPosition;
+
+            auto nameText = addComponent<TMPro::TextMeshProUGUI>(newObject("NameText", root->get_transform()));
+            nameText->text = text;
+
+            auto toggle = addComponent<UnityEngine::UI::Toggle>(newObject("SwitchView", root->get_transform()));
+            toggle->isOn = value;
+            toggle->onValueChanged = std::move(onValueChanged);
+
+            record(Op::CreateToggle, toggle, text);
+            return toggle;
+        }
+
+        /// @brief Like QuestUI, the dropdown sits next to a "Label" text, both inside an object of their own
+        static HMUI::SimpleTextDropdown* createDropdown(UnityEngine::Transform* parent, std::string_view text, std::string_view value,
+                                                        std::span<std::string const> values, std::function<void(std::string_view)> onValueChanged) {
+            auto root = newObject("Dropdown", parent);
+
+            auto label = addComponent<TMPro::TextMeshProUGUI>(newObject("Label", root->get_transform()));
+            label->text = text;
+
+            auto object = newObject("SimpleTextDropdown", root->get_transform());
+            auto dropdown = addComponent<HMUI::SimpleTextDropdown>(object);
+            dropdown->button = addComponent<UnityEngine::UI::Button>(object);
+            dropdown->texts.assign(values.begin(), values.end());
+            dropdown->onValueChanged = std::move(onValueChanged);
+            auto selected = std::find(values.begin(), values.end(), value);
+            dropdown->selectedIndex = selected == values.end() ? 0 : static_cast<int>(selected - values.begin());
+
+            record(Op::CreateDropdown, dropdown, text);
+            return dropdown;
+        }
+
+        static UnityEngine::UI::VerticalLayoutGroup* createVerticalLayoutGroup(UnityEngine::Transform* parent) {
+            auto layout = addComponent<UnityEngine::UI::VerticalLayoutGroup>(newObject("QuestUIVerticalLayoutGroup", parent));
+            record(Op::CreateLayout, layout, {});
+            return layout;
+        }
+
+        static UnityEngine::UI::HorizontalLayoutGroup* createHorizontalLayoutGroup(UnityEngine::Transform* parent) {
+            auto layout = addComponent<UnityEngine::UI::HorizontalLayoutGroup>(newObject("QuestUIHorizontalLayoutGroup", parent));
+            record(Op::CreateLayout, layout, {});
+            return layout;
+        }
+
+        static void setText(TMPro::TextMeshProUGUI* text, std::string_view value) {
+            text->text = Strings::get(value);
+            record(Op::SetText, text, value);
+        }
+
+        /// @brief Stores the chars as UTF-8, like setText. Reuses the memory of the previous text, like TextMeshPro does
+        static void setCharArray(TMPro::TextMeshProUGUI* text, std::u16string_view chars) {
+            auto& utf8 = text->text;
+            utf8.clear();
+            for (size_t i = 0; i < chars.size(); i++) {
+                char32_t codepoint = chars[i];
+                if (codepoint >= 0xD800 && codepoint < 0xDC00 && i + 1 < chars.size()) {
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (chars[++i] - 0xDC00);
+                }
+
+                if (codepoint < 0x80) {
+                    utf8.push_back(static_cast<char>(codepoint));
+                } else if (codepoint < 0x800) {
+                    utf8.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+                    utf8.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+                } else if (codepoint < 0x10000) {
+                    utf8.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+                    utf8.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+                    utf8.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+                } else {
+                    utf8.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+                    utf8.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+                    utf8.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+                    utf8.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+                }
+            }
+            record(Op::SetCharArray, text, utf8);
+        }
+
+        static std::string getText(TMPro::TextMeshProUGUI* text) {
+            return text->text;
+        }
+
+        static void setColor(TMPro::TextMeshProUGUI* text, UnityEngine::Color color) {
+            text->color = color;
+            record(Op::SetColor, text, {});
+        }
+
+        static void setAlpha(TMPro::TextMeshProUGUI* text, float alpha) {
+            text->color.a = alpha;
+            record(Op::SetAlpha, text, {});
+        }
+
+        static void setAnchoredPosition(UnityEngine::RectTransform* rectTransform, UnityEngine::Vector2 position) {
+            rectTransform->anchoredPosition = position;
+            record(Op::SetPosition, rectTransform, {});
+        }
+
+        static void setScale(UnityEngine::Transform* transform, UnityEngine::Vector2 scale) {
+            transform->localScale = scale;
+            record(Op::SetScale, transform, {});
+        }
+
+        static void setEnabled(UnityEngine::Behaviour* behaviour, bool enabled) {
+            behaviour->enabled = enabled;
+            record(Op::SetEnabled, behaviour, {});
+        }
+
+        static void setOnClick(UnityEngine::UI::Button* button, std::function<void()> onClick) {
+            button->onClick = std::move(onClick);
+            record(Op::SetOnClick, button, {});
+        }
+
+        static void setOnValueChanged(UnityEngine::UI::Toggle* toggle, std::function<void(bool)> onValueChanged) {
+            toggle->onValueChanged = std::move(onValueChanged);
+        }
+
+        static void setDropdownTexts(HMUI::SimpleTextDropdown* dropdown, std::span<std::string const> texts) {
+            dropdown->texts.assign(texts.begin(), texts.end());
+            record(Op::SetDropdownTexts, dropdown, {});
+        }
+
+        static UnityEngine::Transform* findChild(UnityEngine::Transform* parent, std::string_view name) {
+            record(Op::FindChild, parent, name);
+            return parent->Find(name);
+        }
+
+#pragma region inspection
+        /// @brief Clicks button like a user would
+        static void click(UnityEngine::UI::Button* button) {
+            if (button->onClick) button->onClick();
+        }
+
+        /// @brief Picks the value at index of dropdown like a user would
+        static void select(HMUI::SimpleTextDropdown* dropdown, int index) {
+            dropdown->selectedIndex = index;
+            if (dropdown->onValueChanged) dropdown->onValueChanged(dropdown->texts[index]);
+        }
+
+        /// @brief Sets what deltaTime() returns, 90 fps by default
+        static void setDeltaTime(float seconds) noexcept {
+            frameTime = seconds;
+        }
+
+        /// @brief Runs the tasks scheduled so far, like a frame of the game would
+        /// @return The amount of tasks run
+        static size_t runFrame() {
+            std::vector<std::function<void()>> frame;
+            {
+                std::lock_guard lock(tasksMutex);
+                frame.swap(tasks);
+            }
+            for (auto& task : frame) {
+                task();
+            }
+            return frame.size();
+        }
+
+        /// @brief How often op was done since the last clearRecords()
+        [[nodiscard]] static size_t count(Op op) noexcept {
+            return counts[static_cast<size_t>(op)];
+        }
+
+        /// @brief Every operation since the last clearRecords(), if recording is on
+        [[nodiscard]] static std::vector<Record> const& records() noexcept {
+            return log;
+        }
+
+        /// @brief Keeps a Record of every operation. Off by default, only counting is cheap enough for benchmarks.
+        static void setRecording(bool enabled) noexcept {
+            recording = enabled;
+        }
+
+        static void clearRecords() noexcept {
+            counts = {};
+            log.clear();
+        }
+
+        /// @brief Frees every object, and drops records and scheduled tasks
+        static void reset() {
+            objects.clear();
+            clearRecords();
+            std::lock_guard lock(tasksMutex);
+            tasks.clear();
+        }
+
+        [[nodiscard]] static size_t objectCount() noexcept {
+            return objects.size();
+        }
+
+        static void crashUnless(bool value, char const* expr, char const* file, int line) {
+            if (value) return;
+            std::fprintf(stderr, "%s:%d: CRASH_UNLESS(%s) failed\n", file, line, expr);
+            std::abort();
+        }
+
+        template<typename T>
+        static T* crashUnless(T* value, char const* expr, char const* file, int line) {
+            crashUnless(value != nullptr, expr, file, line);
+            return value;
+        }
+#pragma endregion
+
+    private:
+        static UnityEngine::GameObject* newObject(std::string_view name, UnityEngine::Transform* parent) {
+            auto object = own(std::make_unique<UnityEngine::GameObject>());
+            object->name = name;
+
+            // everything QUC creates is UI, so every transform is a RectTransform
+            auto transform = addComponent<UnityEngine::RectTransform>(object);
+            object->transform = transform;
+            transform->SetParent(parent, false);
+            return object;
+        }
+
+        template<typename T>
+        static T* addComponent(UnityEngine::GameObject* object) {
+            auto component = own(std::make_unique<T>());
+            component->gameObject = object;
+            object->components.push_back(component);
+            return component;
+        }
+
+        template<typename T>
+        static T* own(std::unique_ptr<T> object) {
+            auto ptr = object.get();
+            objects.emplace_back(std::move(object));
+            return ptr;
+        }
+
+        static void kill(UnityEngine::GameObject* object) {
+            object->m_CachedPtr = nullptr;
+            for (auto component : object->components) {
+                component->m_CachedPtr = nullptr;
+            }
+            for (auto child : object->get_transform()->children) {
+                kill(child->get_gameObject());
+            }
+        }
+
+        static void record(Op op, UnityEngine::Object const* target, std::string_view value) {
+            counts[static_cast<size_t>(op)]++;
+            if (recording) {
+                log.push_back({op, target, std::string(value)});
+            }
+        }
+
+        inline static std::vector<std::unique_ptr<UnityEngine::Object>> objects;
+        inline static std::array<size_t, static_cast<size_t>(Op::Count)> counts{};
+        inline static std::vector<Record> log;
+        inline static bool recording = false;
+        inline static float frameTime = 1.0f / 90.0f;
+
+        inline static std::mutex tasksMutex;
+        inline static std::vector<std::function<void()>> tasks;
+    };
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "questui/shared/BeatSaberUI.hpp"
+#include "questui/shared/CustomTypes/Components/MainThreadScheduler.hpp"
+#include "beatsaber-hook/shared/utils/il2cpp-utils.hpp"
+#include "beatsaber-hook/shared/utils/il2cpp-functions.hpp"
+
+#include "../strings.hpp"
+
+#include "UnityEngine/Object.hpp"
+#include "UnityEngine/GameObject.hpp"
+#include "UnityEngine/Transform.hpp"
+#include "UnityEngine/RectTransform.hpp"
+#include "UnityEngine/Behaviour.hpp"
+#include "UnityEngine/Vector2.hpp"
+#include "UnityEngine/Vector3.hpp"
+#include "UnityEngine/Time.hpp"
+#include "UnityEngine/Color.hpp"
+#include "UnityEngine/UI/Button.hpp"
+#include "UnityEngine/UI/Button_ButtonClickedEvent.hpp"
+#include "UnityEngine/UI/Toggle.hpp"
+#include "UnityEngine/UI/Toggle_ToggleEvent.hpp"
+#include "UnityEngine/UI/VerticalLayoutGroup.hpp"
+#include "UnityEngine/UI/HorizontalLayoutGroup.hpp"
+#include "UnityEngine/Events/UnityAction.hpp"
+#include "UnityEngine/Events/UnityAction_1.hpp"
+#include "TMPro/TextMeshProUGUI.hpp"
+#include "HMUI/CurvedTextMeshPro.hpp"
+#include "HMUI/SimpleTextDropdown.hpp"
+#include "System/Collections/Generic/IReadOnlyList_1.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace QUC::backend {
+    /// @brief Managed strings, held by a GC handle while they are cached
+    struct QuestUIStrings {
+        struct String {
+            Il2CppString* string;
+            uint32_t handle;
+        };
+
+        static String create(std::string_view value) {
+            auto string = il2cpp_utils::newcsstr(value);
+            return {string, il2cpp_functions::gchandle_new(reinterpret_cast<Il2CppObject*>(string), false)};
+        }
+
+        static Il2CppString* get(String const& string) noexcept {
+            return string.string;
+        }
+
+        static void release(String const& string) {
+            il2cpp_functions::gchandle_free(string.handle);
+        }
+    };
+
+    /// @brief A managed char array reused for every setCharArray, held by a GC handle.
+    /// TextMeshPro copies the chars out of it, so one array serves every text.
+    struct QuestUICharBuffer {
+        static ArrayW<Il2CppChar> get(std::u16string_view chars) {
+            if (!array || array->Length() < chars.size()) {
+                if (array) il2cpp_functions::gchandle_free(handle);
+
+                array = Array<Il2CppChar>::NewLength(std::bit_ceil(std::max<size_t>(chars.size(), 64)));
+                handle = il2cpp_functions::gchandle_new(reinterpret_cast<Il2CppObject*>(array), false);
+            }
+            std::copy(chars.begin(), chars.end(), array->values);
+            return ArrayW<Il2CppChar>(array);
+        }
+
+    private:
+        inline static Array<Il2CppChar>* array = nullptr;
+        inline static uint32_t handle = 0;
+    };
+
+    /// @brief The game, through QuestUI and il2cpp
+    struct QuestUIBackend {
+        using Strings = ManagedStringCache<QuestUIStrings>;
+
+        static UnityEngine::GameObject* createObject(std::string_view name) {
+            return UnityEngine::GameObject::New_ctor(Strings::get(name));
+        }
+
+        static void destroy(UnityEngine::GameObject* object) {
+            UnityEngine::Object::Destroy(object);
+        }
+
+        static void scheduleOnMainThread(std::function<void()> task) {
+            QuestUI::MainThreadScheduler::Schedule(std::move(task));
+        }
+
+        /// @brief Seconds since the last frame
+        static float deltaTime() {
+            return UnityEngine::Time::get_deltaTime();
+        }
+
+        /// @brief Whether object and all of its parents are active, i.e. it can be seen
+        static bool isActive(UnityEngine::GameObject* object) {
+            return object->get_activeInHierarchy();
+        }
+
+        static TMPro::TextMeshProUGUI* createText(UnityEngine::Transform* parent, std::string_view text, bool italic, UnityEngine::Vector2 anchoredPosition, UnityEngine::Vector2 sizeDelta) {
+            return QuestUI::BeatSaberUI::CreateText(parent, text, italic, anchoredPosition, sizeDelta);
+        }
+
+        static UnityEngine::UI::Button* createButton(UnityEngine::Transform* parent, std::string_view text, std::string_view buttonTemplate,
+                                                     std::optional<UnityEngine::Vector2> anchoredPosition, std::optional<UnityEngine::Vector2> sizeDelta,
+                                                     std::function<void()> onClick) {
+            if (anchoredPosition && sizeDelta)
+                return QuestUI::BeatSaberUI::CreateUIButton(parent, text, buttonTemplate, *anchoredPosition, *sizeDelta, std::move(onClick));
+            if (anchoredPosition)
+                return QuestUI::BeatSaberUI::CreateUIButton(parent, text, buttonTemplate, *anchoredPosition, std::move(onClick));
+            return QuestUI::BeatSaberUI::CreateUIButton(parent, text, buttonTemplate, std::move(onClick));
+        }
+
+        static UnityEngine::UI::Toggle* createToggle(UnityEngine::Transform* parent, std::string_view text, bool value,
+                                                     std::optional<UnityEngine::Vector2> anchoredPosition, std::function<void(bool)> onValueChanged) {
+            if (anchoredPosition)
+                return QuestUI::BeatSaberUI::CreateToggle(parent, text, value, *anchoredPosition, std::move(onValueChanged));
+            return QuestUI::BeatSaberUI::CreateToggle(parent, text, value, std::move(onValueChanged));
+        }
+
+        static HMUI::SimpleTextDropdown* createDropdown(UnityEngine::Transform* parent, std::string_view text, std::string_view value,
+                                                        std::span<std::string const> values, std::function<void(std::string_view)> onValueChanged) {
+            std::vector<StringW> texts(values.begin(), values.end());
+            return QuestUI::BeatSaberUI::CreateDropdown(parent, text, value, texts, [onValueChanged = std::move(onValueChanged)](StringW chosen) {
+                onValueChanged(static_cast<std::string>(chosen));
+            });
+        }
+
+        static UnityEngine::UI::VerticalLayoutGroup* createVerticalLayoutGroup(UnityEngine::Transform* parent) {
+            return QuestUI::BeatSaberUI::CreateVerticalLayoutGroup(parent);
+        }
+
+        static UnityEngine::UI::HorizontalLayoutGroup* createHorizontalLayoutGroup(UnityEngine::Transform* parent) {
+            return QuestUI::BeatSaberUI::CreateHorizontalLayoutGroup(parent);
+        }
+
+        static void setText(TMPro::TextMeshProUGUI* text, std::string_view value) {
+            text->set_text(Strings::get(value));
+        }
+
+        /// @brief Sets the text from UTF-16 chars without creating a managed string
+        static void setCharArray(TMPro::TextMeshProUGUI* text, std::u16string_view chars) {
+            text->SetCharArray(QuestUICharBuffer::get(chars), 0, static_cast<int>(chars.size()));
+        }
+
+        static std::string getText(TMPro::TextMeshProUGUI* text) {
+            return to_utf8(csstrtostr(text->get_text()));
+        }
+
+        static void setColor(TMPro::TextMeshProUGUI* text, UnityEngine::Color color) {
+            text->set_color(color);
+        }
+
+        static void setAlpha(TMPro::TextMeshProUGUI* text, float alpha) {
+            text->set_alpha(alpha);
+        }
+
+        static void setAnchoredPosition(UnityEngine::RectTransform* rectTransform, UnityEngine::Vector2 position) {
+            rectTransform->set_anchoredPosition(position);
+        }
+
+        /// @brief Sets the x and y of the local scale, UI isn't scaled along z
+        static void setScale(UnityEngine::Transform* transform, UnityEngine::Vector2 scale) {
+            transform->set_localScale(UnityEngine::Vector3(scale.x, scale.y, 1.0f));
+        }
+
+        static void setEnabled(UnityEngine::Behaviour* behaviour, bool enabled) {
+            behaviour->set_enabled(enabled);
+        }
+
+        /// @brief Replaces every click listener of button, e.g. those of a previous owner
+        static void setOnClick(UnityEngine::UI::Button* button, std::function<void()> onClick) {
+            button->set_onClick(UnityEngine::UI::Button::ButtonClickedEvent::New_ctor());
+            button->get_onClick()->AddListener(il2cpp_utils::MakeDelegate<UnityEngine::Events::UnityAction*>(classof(UnityEngine::Events::UnityAction*), onClick));
+        }
+
+        /// @brief Replaces every value listener of toggle, an empty onValueChanged only removes them
+        static void setOnValueChanged(UnityEngine::UI::Toggle* toggle, std::function<void(bool)> onValueChanged) {
+            toggle->set_onValueChanged(UnityEngine::UI::Toggle::ToggleEvent::New_ctor());
+            if (onValueChanged) {
+                toggle->get_onValueChanged()->AddListener(il2cpp_utils::MakeDelegate<UnityEngine::Events::UnityAction_1<bool>*>(classof(UnityEngine::Events::UnityAction_1<bool>*), onValueChanged));
+            }
+        }
+
+        /// @brief Replaces the values the dropdown offers
+        static void setDropdownTexts(HMUI::SimpleTextDropdown* dropdown, std::span<std::string const> texts) {
+            auto list = List<StringW>::New_ctor();
+            for (auto const& text : texts) {
+                list->Add(text);
+            }
+            dropdown->SetTexts(reinterpret_cast<System::Collections::Generic::IReadOnlyList_1<StringW>*>(list));
+        }
+
+        /// @brief Direct child of parent called name, or nullptr
+        static UnityEngine::Transform* findChild(UnityEngine::Transform* parent, std::string_view name) {
+            return parent->Find(Strings::get(name));
+        }
+    };
+}
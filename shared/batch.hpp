@@ -0,0 +1,121 @@
+#pragma once
+
+#include "dirty.hpp"
+#include "key.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace QUC {
+    struct RenderContext;
+
+    namespace detail {
+        /// @brief Work put off until the outermost Batch of this thread ends.
+        /// Each target is applied once, in the order it was first deferred.
+        struct BatchState {
+            using Apply = void (*)(void* target, RenderContext* ctx);
+
+            [[nodiscard]] static bool active() noexcept {
+                return depth > 0;
+            }
+
+            static void begin() noexcept {
+                depth++;
+                PendingWrites::hold();
+            }
+
+            static void end() {
+                if (depth == 1) {
+                    depth = 0;
+                    // the work may open batches of its own
+                    auto applying = std::exchange(deferred, {});
+                    keys.clear();
+                    for (auto const& work : applying) {
+                        work.apply(work.target, work.ctx);
+                    }
+                } else {
+                    depth--;
+                }
+                PendingWrites::release();
+            }
+
+            /// @brief Calls apply(target, ctx) once the batch ends, unless that was already requested
+            /// @return false if no batch is active, the caller should do the work itself
+            static bool defer(void* target, RenderContext* ctx, Apply apply) {
+                if (depth == 0) return false;
+
+                if (keys.insert({target, ctx}).second) {
+                    deferred.push_back({target, ctx, apply});
+                }
+                return true;
+            }
+
+            /// @brief Calls component.update(ctx) once the batch ends
+            /// @return false if no batch is active, the component should update itself
+            template<class T>
+            static bool deferUpdate(T& component, RenderContext& ctx) {
+                return defer(&component, &ctx, [](void* component, RenderContext* ctx) {
+                    static_cast<T*>(component)->update(*ctx);
+                });
+            }
+
+        private:
+            struct Work {
+                void* target;
+                RenderContext* ctx;
+                Apply apply;
+            };
+
+            struct Key {
+                void const* target;
+                RenderContext const* ctx;
+
+                bool operator==(Key const&) const = default;
+            };
+
+            struct KeyHash {
+                size_t operator()(Key const& key) const noexcept {
+                    return hashPointers(key.target, key.ctx);
+                }
+            };
+
+            inline static thread_local uint32_t depth = 0;
+            inline static thread_local std::vector<Work> deferred;
+            inline static thread_local std::unordered_set<Key, KeyHash> keys;
+        };
+    }
+
+    /// @brief Groups state changes made while it is alive into one pass at its end.
+    /// Inside a batch:
+    /// - update(ctx) of built-in components only runs once per component, when the batch ends,
+    /// so writing several of its fields and calling update after each one sets each native property once
+    /// - Signals tell their readers and computed values once, when the batch ends
+    /// - written HeldData are handed to the dirty tracker at the end in one go, each address once
+    /// Deferred work is applied in the order it was first requested. Batches may be nested, only the outermost one flushes.
+    /// Values are written right away, so reading a field or signal inside the batch sees the new value,
+    /// but Computed values are only recomputed when the batch ends.
+    /// Components and signals that deferred work inside a batch have to outlive it. Batches only affect the thread they are created on.
+    struct Batch {
+        Batch() noexcept {
+            detail::BatchState::begin();
+        }
+
+        ~Batch() {
+            detail::BatchState::end();
+        }
+
+        Batch(Batch const&) = delete;
+        Batch& operator=(Batch const&) = delete;
+    };
+
+    /// @brief Calls f inside a Batch and returns what it returns
+    template<class F>
+    requires (std::is_invocable_v<F&&>)
+    decltype(auto) batch(F&& f) {
+        Batch scope;
+        return std::forward<F>(f)();
+    }
+}
@@ -23,18 +23,18 @@ namespace QUC {
             const Key key;
 
             Backgroundable(std::string_view bkgType, bool replace, T&& child_)
-                    : backgroundType(bkgType), replaceExisting(replace), child(child_) {}
+                    : backgroundType(bkgType), replaceExisting(replace), child(std::forward<T>(child_)) {}
             UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
                 auto res = detail::renderSingle(child, ctx);
-                auto backgroundable = data.getData<QuestUI::Backgroundable*>();
+                auto& backgroundable = data.getData<QuestUI::Backgroundable*>();
 
+                // the background type never changes, applying it again would only allocate another string
                 if (!backgroundable) {
                     auto go = res->get_gameObject();
                     backgroundable = go->template AddComponent<QuestUI::Backgroundable*>();
+                    backgroundable->ApplyBackground(il2cpp_utils::newcsstr(backgroundType));
                 }
 
-                backgroundable->ApplyBackground(il2cpp_utils::newcsstr(backgroundType));
-
                 return res;
             }
 
@@ -53,7 +53,7 @@ namespace QUC {
             const Key key;
             const std::string backgroundType;
 
-            BackgroundableContainer(std::string_view type, TArgs... args) : backgroundType(type), Container<TArgs...>(args...) {}
+            BackgroundableContainer(std::string_view type, TArgs... args) : backgroundType(type), Container<TArgs...>(std::forward<TArgs>(args)...) {}
 
             UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
                 auto& container = data.getData<UnityEngine::GameObject*>();
@@ -61,18 +61,18 @@ namespace QUC {
                 if (!container) {
                     container = UnityEngine::GameObject::New_ctor();
                     static auto strName = il2cpp_utils::newcsstr<il2cpp_utils::CreationType::Manual>("BSMLBackground");
-                    container->set_name(strName);
+                    QUC_NATIVE_CALL(container->set_name(strName));
 
                     UnityEngine::Transform* transform = container->get_transform();
 
-                    transform->SetParent(CRASH_UNLESS(&ctx.parentTransform), false);
+                    QUC_NATIVE_CALL(transform->SetParent(CRASH_UNLESS(&ctx.parentTransform), false));
                     container->AddComponent<UnityEngine::UI::ContentSizeFitter *>();
                     auto background = container->AddComponent<QuestUI::Backgroundable *>();
 
                     auto rectTransform = container->GetComponent<UnityEngine::RectTransform *>();
-                    rectTransform->set_anchorMin({0, 0});
-                    rectTransform->set_anchorMax({1, 1});
-                    rectTransform->set_sizeDelta({0, 0});
+                    QUC_NATIVE_CALL(rectTransform->set_anchorMin({0, 0}));
+                    QUC_NATIVE_CALL(rectTransform->set_anchorMax({1, 1}));
+                    QUC_NATIVE_CALL(rectTransform->set_sizeDelta({0, 0}));
 
                     background->ApplyBackground(il2cpp_utils::newcsstr(backgroundType));
                 }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "shared/context.hpp"
+#include "shared/pool.hpp"
 #include "shared/state.hpp"
-#include "questui/shared/BeatSaberUI.hpp"
+#include "shared/backend.hpp"
+#include "shared/function.hpp"
 #include "UnityEngine/Vector2.hpp"
+#include "UnityEngine/RectTransform.hpp"
 #include "UnityEngine/UI/Button.hpp"
 #include "TMPro/TextMeshProUGUI.hpp"
 
@@ -39,7 +42,7 @@ namespace QUC {
 
         template<class F>
         Button(std::string_view txt, F&& callable, bool enabled_ = true, bool interact = true, UnityEngine::UI::Image* img = nullptr, std::optional<UnityEngine::Vector2> anch = std::nullopt, std::optional<UnityEngine::Vector2> sz = std::nullopt, std::string buttonTemplate_ = DEFAULT_BUTTONTEMPLATE)
-            : text(txt), enabled(enabled_), interactable(interact), image(img), anchoredPosition(anch), sizeDelta(sz), buttonTemplate(std::move(buttonTemplate_)), click(callable) {}
+            : text(txt), enabled(enabled_), interactable(interact), image(img), anchoredPosition(anch), sizeDelta(sz), buttonTemplate(std::move(buttonTemplate_)), click(std::forward<F>(callable)) {}
 
         UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
             auto& buttonData = data.getData<RenderButtonData>();
@@ -47,22 +50,24 @@ namespace QUC {
 
             auto& button = buttonData.button;
             if (!button) {
-                std::function<void()> callback = [this, callback = this->click, parent, &ctx]()mutable{
+                // small enough for the inline storage of std::function, the click callback isn't copied into it
+                std::function<void()> callback = [this, parent, &ctx]() {
                     if (click)
                         click(*this, parent, ctx);
                 };
 
-                if (anchoredPosition) {
-                    if (sizeDelta) {
-                        button = QuestUI::BeatSaberUI::CreateUIButton(parent, *text, buttonTemplate, *anchoredPosition,
-                                                                      *sizeDelta, callback);
-                    } else {
-                        button = QuestUI::BeatSaberUI::CreateUIButton(parent, *text, buttonTemplate, *anchoredPosition, callback);
-                    }
-                } else {
-                    button = QuestUI::BeatSaberUI::CreateUIButton(parent, *text, buttonTemplate, callback);
+                // Buttons from different templates, or with defaulted position and size, aren't interchangeable
+                size_t variant = std::hash<std::string>()(buttonTemplate) * 4 + (anchoredPosition ? 1 : 0) + (sizeDelta ? 2 : 0);
+                if (auto pooled = NativePool<Button>::acquire(parent, variant)) {
+                    button = pooled->GetComponent<UnityEngine::UI::Button*>();
+                    NativePool<Button>::track(data, pooled, variant);
+                    reuse(buttonData, std::move(callback));
+                    return button->get_transform();
                 }
 
+                button = QUC_NATIVE_CALL(Backend::createButton(parent, *text, buttonTemplate, anchoredPosition, sizeDelta, callback));
+                NativePool<Button>::track(data, button->get_gameObject(), variant);
+
                 assign<true>(buttonData);
             } else {
                 assign<false>(buttonData);
@@ -72,6 +77,9 @@ namespace QUC {
         }
 
         void update(RenderContext& ctx) {
+            // once per batch, see QUC::Batch
+            if (detail::BatchState::deferUpdate(*this, ctx)) return;
+
             auto& data = ctx.getChildData(key);
             auto& buttonData = data.getData<RenderButtonData>();
 
@@ -85,14 +93,42 @@ namespace QUC {
         }
 
     protected:
+        /// @brief Rebinds a button taken from the pool, replacing the click listener of its previous owner
+        void reuse(RenderButtonData& buttonData, std::function<void()> callback) {
+            auto button = buttonData.button;
+            CRASH_UNLESS(button);
+
+            QUC_NATIVE_CALL(Backend::setOnClick(button, std::move(callback)));
+
+            auto rectTransform = button->GetComponent<UnityEngine::RectTransform *>();
+            if (anchoredPosition)
+                QUC_NATIVE_CALL(rectTransform->set_anchoredPosition(*anchoredPosition));
+            if (sizeDelta)
+                QUC_NATIVE_CALL(rectTransform->set_sizeDelta(*sizeDelta));
+
+            buttonData.buttonText = button->GetComponentInChildren<TMPro::TextMeshProUGUI *>();
+            QUC_NATIVE_CALL(Backend::setText(buttonData.buttonText, *text));
+            text.clear();
+
+            QUC_NATIVE_CALL(Backend::setEnabled(button, *enabled));
+            enabled.clear();
+            if (*image) {
+                QUC_NATIVE_CALL(button->set_image(*image));
+            }
+            image.clear();
+
+            assign<true>(buttonData);
+        }
+
         template<bool created = false>
         void assign(RenderButtonData& buttonData) {
+            QUC_PROFILE_SCOPE("Button::assign");
             auto& button = buttonData.button;
             auto& buttonText = buttonData.buttonText;
 
             CRASH_UNLESS(button);
             if (enabled) {
-                button->set_enabled(*enabled);
+                QUC_NATIVE_CALL(Backend::setEnabled(button, *enabled));
                 enabled.clear();
             }
             if (!*enabled) {
@@ -101,10 +137,10 @@ namespace QUC {
             }
 
             if constexpr (created) {
-                button->set_interactable(*interactable);
+                QUC_NATIVE_CALL(button->set_interactable(*interactable));
                 interactable.clear();
             } else if (interactable) {
-                button->set_interactable(*interactable);
+                QUC_NATIVE_CALL(button->set_interactable(*interactable));
                 interactable.clear();
             }
 
@@ -113,17 +149,17 @@ namespace QUC {
                     if (!buttonText)
                         buttonText = button->GetComponentInChildren<TMPro::TextMeshProUGUI *>();
 
-                    buttonText->set_text(il2cpp_utils::newcsstr(*text));
+                    QUC_NATIVE_CALL(Backend::setText(buttonText, *text));
                     text.clear();
                 }
                 if (image) {
-                    button->set_image(*image);
+                    QUC_NATIVE_CALL(button->set_image(*image));
                     image.clear();
                 }
             }
         }
     private:
-        std::function<void(Button& button, UnityEngine::Transform* transform, RenderContext& ctx)> click;
+        InlineFunction<void(Button& button, UnityEngine::Transform* transform, RenderContext& ctx)> click;
     };
     static_assert(renderable<Button>);
     static_assert(cloneable<Button>);
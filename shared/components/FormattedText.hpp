@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Text.hpp"
+#include "../format.hpp"
+
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace QUC {
+    /// @brief A Text showing values in a template that is fixed at compile time, for labels that change often
+    /// such as counters and timers. Rich text tags can be part of the template:
+    /// ```cpp
+    /// FormattedText<"Score: <color=#FFD700>{}</color> ({:.1}%)", int, float> score(0, 0.0f);
+    /// score.set(1200, 98.5f);
+    /// ```
+    /// Updates format into buffers shared by every FormattedText and hand the characters to TextMeshPro directly,
+    /// so they don't create a managed string, or allocate at all once the buffers are big enough.
+    /// Only creating the text allocates its initial string. The text field of the Text is unused and never written.
+    template<FixedString format, typename... Args>
+    struct FormattedText : Text {
+        HeldData<std::tuple<Args...>> values;
+
+        FormattedText(Args... args, bool enabled_ = true, std::optional<Sombrero::FastColor> c = std::nullopt, float fontSize_ = 4, bool italic_ = true,
+                      UnityEngine::Vector2 anch = {0.0f, 0.0f}, UnityEngine::Vector2 sd = {60.0f, 10.0f})
+                : Text("", enabled_, c, fontSize_, italic_, anch, sd), values(std::tuple<Args...>(std::move(args)...)) {}
+
+        void set(Args... args) {
+            values = std::tuple<Args...>(std::move(args)...);
+        }
+
+        UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
+            auto& textComp = data.getData<TMPro::TextMeshProUGUI*>();
+            if (!textComp) {
+                // created, or taken from the pool, with the formatted text. Not written to text, which would
+                // mark this dirty again and make the next render visit it for nothing.
+                auto transform = renderText(ctx, data, formatted());
+                values.clear();
+                return transform;
+            }
+
+            // formats once it is shown again
+            if (!*enabled) return Text::render(ctx, data);
+
+            bool reformat = values || italic;
+            // Text would set its own text when italic changes
+            italic.clear();
+            auto transform = Text::render(ctx, data);
+            if (reformat) {
+                QUC_NATIVE_CALL(Backend::setCharArray(textComp, chars(*italic)));
+                values.clear();
+            }
+            return transform;
+        }
+
+    protected:
+        /// @brief The formatted values, in a buffer shared by every FormattedText. Valid until the next call.
+        std::string_view formatted() const {
+            auto& buffer = detail::FormatBuffers::utf8;
+            buffer.clear();
+            detail::formatTo<format>(buffer, *values);
+            return buffer;
+        }
+
+        /// @brief The formatted values as UTF-16, in a buffer shared by every FormattedText. Valid until the next call.
+        std::u16string_view chars(bool italicized) const {
+            auto& buffer = detail::FormatBuffers::utf8;
+            buffer.clear();
+            if (italicized) buffer.append("<i>");
+            detail::formatTo<format>(buffer, *values);
+            if (italicized) buffer.append("</i>");
+
+            auto& utf16 = detail::FormatBuffers::utf16;
+            utf16.clear();
+            detail::appendUtf16(utf16, buffer);
+            return utf16;
+        }
+    };
+}
@@ -18,7 +18,7 @@ namespace QUC {
             std::string text;
             const Key key;
 
-            HoverHint(std::string_view txt, T&& arg) : text(txt), child(arg) {}
+            HoverHint(std::string_view txt, T&& arg) : text(txt), child(std::forward<T>(arg)) {}
 
             UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
                 auto& hoverHint = data.getData<HMUI::HoverHint*>();
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "shared/context.hpp"
+#include "shared/pool.hpp"
 #include "shared/state.hpp"
 
 #include "questui/shared/BeatSaberUI.hpp"
 
 #include "UnityEngine/Vector2.hpp"
+#include "UnityEngine/RectTransform.hpp"
 
 namespace UnityEngine {
     class Sprite;
@@ -28,7 +30,15 @@ namespace QUC {
         UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
             auto& image = data.getData<HMUI::ImageView*>();
             if (!image) {
-                image = QuestUI::BeatSaberUI::CreateImage(&ctx.parentTransform, *sprite, anchoredPosition, sizeDelta);
+                if (auto pooled = NativePool<Image>::acquire(&ctx.parentTransform)) {
+                    image = pooled->GetComponent<HMUI::ImageView*>();
+                    NativePool<Image>::track(data, pooled);
+                    reuse(image);
+                    return image->get_transform();
+                }
+
+                image = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateImage(&ctx.parentTransform, *sprite, anchoredPosition, sizeDelta));
+                NativePool<Image>::track(data, image->get_gameObject());
                 assign<true>(image);
             } else {
                 assign<false>(image);
@@ -37,12 +47,29 @@ namespace QUC {
         }
 
     protected:
+        /// @brief Sets what CreateImage would have set on an image taken from the pool
+        void reuse(HMUI::ImageView* image) {
+            CRASH_UNLESS(image);
+
+            QUC_NATIVE_CALL(image->set_sprite(*sprite));
+            sprite.clear();
+
+            auto rectTransform = image->get_rectTransform();
+            QUC_NATIVE_CALL(rectTransform->set_anchoredPosition(anchoredPosition));
+            QUC_NATIVE_CALL(rectTransform->set_sizeDelta(sizeDelta));
+
+            QUC_NATIVE_CALL(image->set_enabled(*enabled));
+            enabled.clear();
+            assign<true>(image);
+        }
+
         template<bool created = false>
         void assign(HMUI::ImageView* image) {
+            QUC_PROFILE_SCOPE("Image::assign");
             CRASH_UNLESS(image);
 
             if (enabled) {
-                image->set_enabled(*enabled);
+                QUC_NATIVE_CALL(image->set_enabled(*enabled));
                 enabled.clear();
             }
             if (!*enabled) {
@@ -52,7 +79,7 @@ namespace QUC {
 
             if constexpr (!created) {
                 if (sprite) {
-                    image->set_sprite(*sprite);
+                    QUC_NATIVE_CALL(image->set_sprite(*sprite));
                     sprite.clear();
                 }
             }
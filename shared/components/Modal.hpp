@@ -3,6 +3,7 @@
 #include "shared/components/Text.hpp"
 #include "shared/RootContainer.hpp"
 #include "shared/context.hpp"
+#include "shared/function.hpp"
 
 #include "questui/shared/BeatSaberUI.hpp"
 
@@ -19,7 +20,8 @@ namespace QUC {
     struct ModalWrapper;
 
     using ModalPtrWrapper = std::shared_ptr<ModalWrapper>;
-    using ModalCallback = std::function<void(ModalWrapper *, HMUI::ModalView *)>;
+    /// @brief Move-only, the ModalWrapper holding it is shared instead of copied
+    using ModalCallback = UniqueFunction<void(ModalWrapper *, HMUI::ModalView *)>;
 
     struct ModalWrapper {
     public:
@@ -76,24 +78,25 @@ namespace QUC {
             auto &innerModal = data.getData<HMUI::ModalView *>();
             // if inner modal is already created, skip recreating and forward render calls
             if (!innerModal) {
-                std::function<void(HMUI::ModalView *)> cbk([callback = modalViewPtr->callback, this](HMUI::ModalView *arg) {
-                    if (callback)
-                        callback(modalViewPtr.get(), arg);
+                // keeps the wrapper alive as long as the modal
+                std::function<void(HMUI::ModalView *)> cbk([wrapper = modalViewPtr](HMUI::ModalView *arg) {
+                    if (wrapper->callback)
+                        wrapper->callback(wrapper.get(), arg);
                 });
 
 
                 if (modalViewPtr->sizeDelta) {
                     if (modalViewPtr->anchoredPosition) {
-                        innerModal = QuestUI::BeatSaberUI::CreateModal(&ctx.parentTransform, *modalViewPtr->sizeDelta,
-                                                                       *modalViewPtr->anchoredPosition, cbk,
-                                                                       modalViewPtr->dismissOnBlockerClicked);
+                        innerModal = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateModal(&ctx.parentTransform, *modalViewPtr->sizeDelta,
+                                                                                       *modalViewPtr->anchoredPosition, cbk,
+                                                                                       modalViewPtr->dismissOnBlockerClicked));
                     } else {
-                        innerModal = QuestUI::BeatSaberUI::CreateModal(&ctx.parentTransform, *modalViewPtr->sizeDelta, cbk,
-                                                                       modalViewPtr->dismissOnBlockerClicked);
+                        innerModal = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateModal(&ctx.parentTransform, *modalViewPtr->sizeDelta, cbk,
+                                                                                       modalViewPtr->dismissOnBlockerClicked));
                     }
                 } else {
-                    innerModal = QuestUI::BeatSaberUI::CreateModal(&ctx.parentTransform, cbk,
-                                                                   modalViewPtr->dismissOnBlockerClicked);
+                    innerModal = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateModal(&ctx.parentTransform, cbk,
+                                                                                   modalViewPtr->dismissOnBlockerClicked));
                 }
 
                 modalViewPtr->modalViewPtr = innerModal;
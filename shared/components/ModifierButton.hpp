@@ -78,13 +78,13 @@ namespace QUC
                 };
                 if (anchoredPosition)
                 {
-                    toggle = QuestUI::BeatSaberUI::CreateModifierButton(parent, usableText, *toggleButton.value,
-                                                                        *image.sprite, cbk, *anchoredPosition);
+                    toggle = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateModifierButton(parent, usableText, *toggleButton.value,
+                                                                                        *image.sprite, cbk, *anchoredPosition));
                 }
                 else
                 {
-                    toggle = QuestUI::BeatSaberUI::CreateModifierButton(parent, usableText, *toggleButton.value,
-                                                                        *image.sprite, cbk);
+                    toggle = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateModifierButton(parent, usableText, *toggleButton.value,
+                                                                                        *image.sprite, cbk));
                 }
                 text.text.clear();
                 image.sprite.clear();
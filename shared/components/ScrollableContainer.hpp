@@ -14,7 +14,7 @@ namespace QUC {
     template<class... TArgs>
     requires ((renderable<TArgs> && ...))
     struct ScrollableContainer : detail::Container<TArgs...> {
-        ScrollableContainer(TArgs... args) : detail::Container<TArgs...>(args...) {}
+        ScrollableContainer(TArgs... args) : detail::Container<TArgs...>(std::forward<TArgs>(args)...) {}
 
         const Key key;
 
@@ -23,7 +23,7 @@ namespace QUC {
             auto &parent = ctx.parentTransform;
             if (!scrollContainer) {
                 // It's actually EASIER for us to destroy and remake the entire tree instead of changing some elements.
-                scrollContainer = QuestUI::BeatSaberUI::CreateScrollableSettingsContainer(&parent);
+                scrollContainer = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateScrollableSettingsContainer(&parent));
             }
 
             RenderContext& childrenCtx = data.getChildContext([scrollContainer]() {
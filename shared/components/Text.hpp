@@ -1,9 +1,13 @@
 #pragma once
 
 #include "../context.hpp"
+#include "../pool.hpp"
+#include "../backend.hpp"
 #include "shared/state.hpp"
 
 
+#include <array>
+#include <cstddef>
 #include <string>
 
 #include "UnityEngine/Vector2.hpp"
@@ -11,47 +15,35 @@
 #include "UnityEngine/RectTransform.hpp"
 
 #include "TMPro/TextMeshProUGUI.hpp"
-#include "HMUI/CurvedTextMeshPro.hpp"
-
-
-#include "questui/shared/BeatSaberUI.hpp"
 
 #include "sombrero/shared/ColorUtils.hpp"
 #include "sombrero/shared/Vector2Utils.hpp"
 
-#include "beatsaber-hook/shared/utils/il2cpp-utils.hpp"
-
 namespace QUC {
     struct Text {
         Text(Text const &text) = default;
-
-        HeldData<std::string> text;
-        HeldData<bool> enabled;
-        HeldData<std::optional<Sombrero::FastColor>> color;
-        HeldData<float> fontSize;
-        HeldData<bool> italic;
+        Text(Text&&) = default;
+
+        ModifiedMask<5> modified;
+        TrackedData<std::string, Text, 0> text;
+        TrackedData<bool, Text, 1> enabled;
+        TrackedData<std::optional<Sombrero::FastColor>, Text, 2> color;
+        TrackedData<float, Text, 3> fontSize;
+        TrackedData<bool, Text, 4> italic;
         Sombrero::FastVector2 anchoredPosition;
         Sombrero::FastVector2 sizeDelta;
 
         const Key key;
 
+        static constexpr size_t trackedOffset(size_t bit) {
+            return std::array{offsetof(Text, text), offsetof(Text, enabled), offsetof(Text, color), offsetof(Text, fontSize), offsetof(Text, italic)}[bit];
+        }
+
         Text(std::string_view t = "", bool enabled_ = true, std::optional<Sombrero::FastColor> c = std::nullopt, float fontSize_ = 4, bool italic_ = true, UnityEngine::Vector2 anch = {0.0f, 0.0f}, UnityEngine::Vector2 sd = {60.0f, 10.0f})
             : text(t), enabled(enabled_), color(c), fontSize(fontSize_), italic(italic_), anchoredPosition(anch), sizeDelta(sd) {}
 
         UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
-            auto& textComp = data.getData<TMPro::TextMeshProUGUI*>();
-            auto& parent = ctx.parentTransform;
-            // Recreating our own is not very bueno... ASSUMING we can avoid it, which we should be able to.
-            if (textComp) {
-                // Rewrite our existing text instance instead of making a new one
-                assign(textComp);
-            } else {
-                textComp = QuestUI::BeatSaberUI::CreateText(&parent, text.getData(), *italic, anchoredPosition,
-                                                            sizeDelta);
-
-                assign<true>(textComp);
-            }
-            return textComp->get_transform();
+            return renderText(ctx, data, text.getData());
         }
 
 
@@ -63,7 +55,7 @@ namespace QUC {
                 sizeDelta(textComp->get_rectTransform()->get_sizeDelta()) {
             CRASH_UNLESS(textComp);
 
-            text = to_utf8(csstrtostr(textComp->get_text()));
+            text = Backend::getText(textComp);
             italic = text.getData().starts_with("<i>") && text.getData().ends_with("</i>");
             fontSize = textComp->get_fontSize();
             enabled = textComp->get_enabled();
@@ -79,7 +71,7 @@ namespace QUC {
             sizeDelta = rectTransform->get_sizeDelta();
 
 
-            text = to_utf8(csstrtostr(textComp->get_text()));
+            text = Backend::getText(textComp);
             italic = text.getData().starts_with("<i>") && text.getData().ends_with("</i>");
             fontSize = textComp->get_fontSize();
             enabled = textComp->get_enabled();
@@ -90,11 +82,61 @@ namespace QUC {
         }
 
     protected:
+        /// @brief text wrapped in italic tags, in a buffer reused by every Text. Valid until the next call.
+        static std::string_view italicized(std::string_view text) {
+            static std::string buffer;
+            buffer.assign("<i>").append(text).append("</i>");
+            return buffer;
+        }
+
+        /// @brief Renders the text, creating it with initialText instead of text if it doesn't exist yet
+        UnityEngine::Transform* renderText(RenderContext& ctx, RenderContextChildData& data, std::string_view initialText) {
+            auto& textComp = data.getData<TMPro::TextMeshProUGUI*>();
+            auto& parent = ctx.parentTransform;
+            // Recreating our own is not very bueno... ASSUMING we can avoid it, which we should be able to.
+            if (textComp) {
+                // Rewrite our existing text instance instead of making a new one
+                assign(textComp);
+            } else if (auto pooled = NativePool<Text>::acquire(&parent)) {
+                textComp = pooled->GetComponent<TMPro::TextMeshProUGUI*>();
+                NativePool<Text>::track(data, pooled);
+                reuse(textComp, initialText);
+            } else {
+                textComp = QUC_NATIVE_CALL(Backend::createText(&parent, initialText, *italic, anchoredPosition, sizeDelta));
+                NativePool<Text>::track(data, textComp->get_gameObject());
+
+                assign<true>(textComp);
+            }
+            return textComp->get_transform();
+        }
+
+        /// @brief Sets what CreateText would have set on a text taken from the pool, then assigns like on creation
+        void reuse(TMPro::TextMeshProUGUI* textComp, std::string_view initialText) {
+            CRASH_UNLESS(textComp);
+
+            QUC_NATIVE_CALL(Backend::setText(textComp, *italic ? italicized(initialText) : initialText));
+            text.clear();
+            italic.clear();
+
+            QUC_NATIVE_CALL(Backend::setEnabled(textComp, *enabled));
+            enabled.clear();
+            // the previous owner may have colored it
+            if (!*color) {
+                QUC_NATIVE_CALL(Backend::setColor(textComp, UnityEngine::Color::get_white()));
+            }
+
+            assign<true>(textComp);
+        }
+
         template<bool created = false>
         void assign(TMPro::TextMeshProUGUI* textComp) {
+            QUC_PROFILE_SCOPE("Text::assign");
             CRASH_UNLESS(textComp);
+            if constexpr (!created) {
+                if (!modified.any()) return;
+            }
             if (enabled) {
-                textComp->set_enabled(*enabled);
+                QUC_NATIVE_CALL(Backend::setEnabled(textComp, *enabled));
                 enabled.clear();
             }
             if (!*enabled) {
@@ -104,50 +146,44 @@ namespace QUC {
 
             if constexpr (!created) {
                 // Only set these properties if we did NOT JUST create the text.
-                Il2CppString* text_cs = nullptr;
-
-                if (italic) {
-                    if (*italic) {
-                        text_cs = il2cpp_utils::newcsstr("<i>" + std::string(text) + "</i>");
-                    }
+                if (italic || text) {
+                    QUC_NATIVE_CALL(Backend::setText(textComp, *italic ? italicized(*text) : std::string_view(*text)));
                     italic.clear();
-                }
-                else if (text) {
-                    text_cs = il2cpp_utils::newcsstr(text.getData());
                     text.clear();
                 }
 
-
-                if (text_cs) { textComp->set_text(text_cs); }
-
                 if (fontSize) {
-                    textComp->set_fontSize(*fontSize);
+                    QUC_NATIVE_CALL(textComp->set_fontSize(*fontSize));
                     fontSize.clear();
                 }
                 if (color) {
                     if (*color)
-                        textComp->set_color(**color);
+                        QUC_NATIVE_CALL(Backend::setColor(textComp, **color));
 
                     color.clear();
                 }
             }
 
             if constexpr (created) {
-                textComp->set_fontSize(fontSize.getData());
+                // set when the text was created
+                text.clear();
+                italic.clear();
+
+                QUC_NATIVE_CALL(textComp->set_fontSize(fontSize.getData()));
                 fontSize.clear();
                 if (*color) {
-                    textComp->set_color(**color);
+                    QUC_NATIVE_CALL(Backend::setColor(textComp, **color));
                 }
                 color.clear();
 
                 auto rectTransform = textComp->get_rectTransform();
 
-                rectTransform->set_anchoredPosition(anchoredPosition);
-                rectTransform->set_sizeDelta(sizeDelta);
-                rectTransform->set_anchorMin(UnityEngine::Vector2(0.5f, 0.5f));
-                rectTransform->set_anchorMax(UnityEngine::Vector2(0.5f, 0.5f));
+                QUC_NATIVE_CALL(rectTransform->set_anchoredPosition(anchoredPosition));
+                QUC_NATIVE_CALL(rectTransform->set_sizeDelta(sizeDelta));
+                QUC_NATIVE_CALL(rectTransform->set_anchorMin(UnityEngine::Vector2(0.5f, 0.5f)));
+                QUC_NATIVE_CALL(rectTransform->set_anchorMax(UnityEngine::Vector2(0.5f, 0.5f)));
 
-                textComp->set_richText(true);
+                QUC_NATIVE_CALL(textComp->set_richText(true));
             }
         }
 
@@ -2,6 +2,7 @@
 
 #include "shared/context.hpp"
 #include "shared/RootContainer.hpp"
+#include "shared/pool.hpp"
 #include "UnityEngine/UI/GridLayoutGroup.hpp"
 #include "questui/shared/BeatSaberUI.hpp"
 
@@ -11,7 +12,7 @@ namespace QUC {
         requires ((renderable<TArgs> && ...))
         struct GridLayoutGroup : Container<TArgs...> {
             static_assert(renderable<GridLayoutGroup<TArgs...>>);
-            GridLayoutGroup(TArgs... args) : Container<TArgs...>(args...) {}
+            GridLayoutGroup(TArgs... args) : Container<TArgs...>(std::forward<TArgs>(args)...) {}
 
             const Key key;
 
@@ -19,11 +20,16 @@ namespace QUC {
                 auto& gridLayoutGroup = data.getData<UnityEngine::UI::GridLayoutGroup*>();
                 auto &parent = ctx.parentTransform;
                 if (!gridLayoutGroup) {
-                    // It's actually EASIER for us to destroy and remake the entire tree instead of changing some elements.
-                    gridLayoutGroup = QuestUI::BeatSaberUI::CreateGridLayoutGroup(&parent);
+                    if (auto pooled = NativePool<UnityEngine::UI::GridLayoutGroup>::acquire(&parent)) {
+                        gridLayoutGroup = pooled->GetComponent<UnityEngine::UI::GridLayoutGroup*>();
+                    } else {
+                        // It's actually EASIER for us to destroy and remake the entire tree instead of changing some elements.
+                        gridLayoutGroup = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateGridLayoutGroup(&parent));
+                    }
+                    NativePool<UnityEngine::UI::GridLayoutGroup>::track(data, gridLayoutGroup->get_gameObject());
                 }
 
-                RenderContext& childrenCtx = ctx.getChildContext<UnityEngine::UI::GridLayoutGroup>(key, [gridLayoutGroup]() {
+                RenderContext& childrenCtx = data.getChildContext([gridLayoutGroup]() {
                     return gridLayoutGroup->get_transform();
                 });
                 detail::Container<TArgs...>::render(childrenCtx, data);
@@ -2,15 +2,16 @@
 
 #include "shared/context.hpp"
 #include "shared/RootContainer.hpp"
+#include "shared/pool.hpp"
 #include "UnityEngine/UI/HorizontalLayoutGroup.hpp"
-#include "questui/shared/BeatSaberUI.hpp"
+#include "shared/backend.hpp"
 
 namespace QUC {
     namespace detail {
         template<class... TArgs>
         requires ((renderable<TArgs> && ...))
         struct HorizontalLayoutGroup : Container<TArgs...> {
-            HorizontalLayoutGroup(TArgs... args) : Container<TArgs...>(args...) {}
+            HorizontalLayoutGroup(TArgs... args) : Container<TArgs...>(std::forward<TArgs>(args)...) {}
 
             const Key key;
 
@@ -18,8 +19,13 @@ namespace QUC {
                 auto& horizontalLayout = data.getData<UnityEngine::UI::HorizontalLayoutGroup*>();
                 auto &parent = ctx.parentTransform;
                 if (!horizontalLayout) {
-                    // It's actually EASIER for us to destroy and remake the entire tree instead of changing some elements.
-                    horizontalLayout = QuestUI::BeatSaberUI::CreateHorizontalLayoutGroup(&parent);
+                    if (auto pooled = NativePool<UnityEngine::UI::HorizontalLayoutGroup>::acquire(&parent)) {
+                        horizontalLayout = pooled->GetComponent<UnityEngine::UI::HorizontalLayoutGroup*>();
+                    } else {
+                        // It's actually EASIER for us to destroy and remake the entire tree instead of changing some elements.
+                        horizontalLayout = QUC_NATIVE_CALL(Backend::createHorizontalLayoutGroup(&parent));
+                    }
+                    NativePool<UnityEngine::UI::HorizontalLayoutGroup>::track(data, horizontalLayout->get_gameObject());
                 }
 
                 RenderContext& childrenCtx = data.getChildContext([horizontalLayout]() {
@@ -5,6 +5,7 @@
 #include "UnityEngine/UI/ContentSizeFitter.hpp"
 
 #include "shared/RootContainer.hpp"
+#include "shared/pool.hpp"
 #include "questui/shared/BeatSaberUI.hpp"
 
 namespace QUC {
@@ -12,7 +13,7 @@ namespace QUC {
         template<class... TArgs>
         requires ((renderable<TArgs> && ...))
         struct ModifierContainer : Container<TArgs...> {
-            ModifierContainer(TArgs... args) : Container<TArgs...>(args...) {}
+            ModifierContainer(TArgs... args) : Container<TArgs...>(std::forward<TArgs>(args)...) {}
 
             const Key key;
 
@@ -20,8 +21,14 @@ namespace QUC {
                 auto& modifierLayout = data.getData<UnityEngine::UI::VerticalLayoutGroup*>();
                 auto &parent = ctx.parentTransform;
                 if (!modifierLayout) {
-                    // It's actually EASIER for us to destroy and remake the entire tree instead of changing some elements.
-                    modifierLayout = QuestUI::BeatSaberUI::CreateModifierContainer(&parent);
+                    // modifier containers are vertical layout groups set up differently
+                    if (auto pooled = NativePool<UnityEngine::UI::VerticalLayoutGroup>::acquire(&parent, 1)) {
+                        modifierLayout = pooled->GetComponent<UnityEngine::UI::VerticalLayoutGroup*>();
+                    } else {
+                        // It's actually EASIER for us to destroy and remake the entire tree instead of changing some elements.
+                        modifierLayout = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateModifierContainer(&parent));
+                    }
+                    NativePool<UnityEngine::UI::VerticalLayoutGroup>::track(data, modifierLayout->get_gameObject(), 1);
                 }
 
                 RenderContext& childrenCtx = data.getChildContext([modifierLayout]() {
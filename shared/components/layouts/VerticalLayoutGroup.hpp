@@ -1,7 +1,8 @@
 #pragma once
 
 #include "shared/RootContainer.hpp"
-#include "questui/shared/BeatSaberUI.hpp"
+#include "shared/pool.hpp"
+#include "shared/backend.hpp"
 
 namespace QUC {
     namespace detail {
@@ -10,14 +11,19 @@ namespace QUC {
         struct VerticalLayoutGroup : Container<TArgs...> {
             const Key key;
 
-            VerticalLayoutGroup(TArgs... args) : Container<TArgs...>(args...) {}
+            VerticalLayoutGroup(TArgs... args) : Container<TArgs...>(std::forward<TArgs>(args)...) {}
 
             UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
                 auto& viewLayout = data.getData<UnityEngine::UI::VerticalLayoutGroup*>();
                 auto &parent = ctx.parentTransform;
                 if (!viewLayout) {
-                    // It's actually EASIER for us to destroy and remake the entire tree instead of changing some elements.
-                    viewLayout = QuestUI::BeatSaberUI::CreateVerticalLayoutGroup(&parent);
+                    if (auto pooled = NativePool<UnityEngine::UI::VerticalLayoutGroup>::acquire(&parent)) {
+                        viewLayout = pooled->GetComponent<UnityEngine::UI::VerticalLayoutGroup*>();
+                    } else {
+                        // It's actually EASIER for us to destroy and remake the entire tree instead of changing some elements.
+                        viewLayout = QUC_NATIVE_CALL(Backend::createVerticalLayoutGroup(&parent));
+                    }
+                    NativePool<UnityEngine::UI::VerticalLayoutGroup>::track(data, viewLayout->get_gameObject());
                 }
 
                 RenderContext& childrenCtx = data.getChildContext([viewLayout] {
@@ -64,7 +64,7 @@ namespace QUC {
                     }
                 };
 
-                dataSource = QUC::CustomTypeList::CreateCustomList<DataSource>(&ctx.parentTransform, buildCell, initData);
+                dataSource = QUC::CustomTypeList::CreateCustomList<DataSource>(&ctx.parentTransform, std::move(buildCell), initData);
                 dataSource->descriptors = cellDatas;
                 dataSource->Init(initData);
             }
@@ -19,10 +19,13 @@
 #include "custom-types/shared/macros.hpp"
 #include "shared/UnsafeAny.hpp"
 #include "shared/key.hpp"
+#include "shared/profiler.hpp"
 #include "shared/concepts.hpp"
+#include "shared/function.hpp"
 
 #include <functional>
 #include <concepts>
+#include <type_traits>
 
 #define GET_FIND_METHOD(mPtr) \
     il2cpp_utils::il2cpp_type_check::MetadataGetter<mPtr>::get()
@@ -51,7 +54,7 @@ namespace QUC::CustomTypeList {
         static auto playerTableCellStr = il2cpp_utils::newcsstr<il2cpp_utils::CreationType::Manual>("GlobalLeaderboardTableCell");
         auto cellGO = UnityEngine::GameObject::New_ctor();
         auto playerCell = cellGO->AddComponent<T *>();
-        cellGO->set_name(playerTableCellStr);
+        QUC_NATIVE_CALL(cellGO->set_name(playerTableCellStr));
         playerCell->Setup();
         return playerCell;
     }
@@ -74,9 +77,9 @@ namespace QUC::CustomTypeList {
         IsValidQUCTableCell<typename T::CustomQUCCustomCellT>;
 
         typename T::CreateCellCallback;
-        IsQUCConvertible<typename T::CreateCellCallback, std::function<void(typename T::CustomQUCCustomCellT*, bool, typename T::CustomQUCDescriptorT const& descriptor)>>;
+        requires std::is_invocable_v<typename T::CreateCellCallback&, typename T::CustomQUCCustomCellT*, bool, typename T::CustomQUCDescriptorT const&>;
 
-        {t.buildCell} -> IsQUCConvertible<std::function<void(typename T::CustomQUCCustomCellT*, bool, typename T::CustomQUCDescriptorT const& descriptor)>>;
+        {t.buildCell} -> std::same_as<typename T::CreateCellCallback&>;
         {t.tableView} -> IsQUCConvertible<QuestUI::TableView*>;
         {t.descriptors} -> IsQUCConvertible<std::vector<typename T::CustomQUCDescriptorT>>;
         {t.Init(initData)};
@@ -103,8 +106,8 @@ ___DECLARE_TYPE_WRAPPER_INHERITANCE(namespaze, name, Il2CppTypeEnum::IL2CPP_TYPE
             void Init(QUC::CustomTypeList::QUCTableInitData const& initData); \
             \
             \
-            std::function<HMUI::TableCell*(HMUI::TableView* tableView, int idx)> getCellForIdx = nullptr; \
-            using CreateCellCallback = std::function<void(CustomQUCCustomCellT* cell, bool created, CustomQUCDescriptorT const& descriptor)>; \
+            QUC::UniqueFunction<HMUI::TableCell*(HMUI::TableView* tableView, int idx)> getCellForIdx = nullptr; \
+            using CreateCellCallback = QUC::UniqueFunction<void(CustomQUCCustomCellT* cell, bool created, CustomQUCDescriptorT const& descriptor)>; \
             \
             CreateCellCallback buildCell; \
             \
@@ -181,12 +184,12 @@ namespace QUC::CustomTypeList {
     TableData *CreateCustomList(UnityEngine::Transform *parent, CreateCellCallback createCell, QUCTableInitData const& initData) {
         TableData* list;
         if (initData.scrollable) {
-            list = QuestUI::BeatSaberUI::CreateScrollableCustomSourceList<TableData *>(parent, initData.anchorPosition, initData.sizeDelta);
+            list = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateScrollableCustomSourceList<TableData *>(parent, initData.anchorPosition, initData.sizeDelta));
         } else {
-            list = QuestUI::BeatSaberUI::CreateCustomSourceList<TableData *>(parent, initData.anchorPosition, initData.sizeDelta);
+            list = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateCustomSourceList<TableData *>(parent, initData.anchorPosition, initData.sizeDelta));
         }
 
-        list->buildCell = createCell;
+        list->buildCell = std::move(createCell);
 
         return list;
     }
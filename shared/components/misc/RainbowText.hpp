@@ -1,13 +1,7 @@
 #pragma once
 
 #include "shared/components/Text.hpp"
-#include "custom-types/shared/coroutine.hpp"
-
-#include "System/Collections/IEnumerator.hpp"
-#include "UnityEngine/WaitForSecondsRealtime.hpp"
-#include "UnityEngine/Time.hpp"
-
-#include "sombrero/shared/ColorUtils.hpp"
+#include "shared/animation.hpp"
 
 #include <utility>
 #include <vector>
@@ -19,50 +13,49 @@ namespace UnityEngine {
 }
 
 namespace QUC {
+    /// @brief A Text cycling through every hue of its color, starting from red if it has none.
+    /// The colors are set by the Animator, so the text itself is only rendered when it changes.
     class RainbowText : public Text {
     public:
         explicit RainbowText(std::string_view prefix) : Text(prefix) {}
 
+    /// @brief Hue cycles every 4 seconds at 1
     float speed = 1.0f;
     const Key key;
 
     UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
-        auto ret = Text::render(ctx, ctx.getChildData(Text::key));
-
-        auto& text = data.getData<TMPro::TextMeshProUGUI *>();
-
-        if (!text) {
-            text = ctx.getChildData(Text::key).getData<TMPro::TextMeshProUGUI *>();
-            text->StartCoroutine(custom_types::Helpers::CoroutineHelper::New(
-                            rainbowCoroutine(ctx, data)));
+        auto& textData = ctx.getChildData(Text::key);
+        auto ret = Text::render(ctx, textData);
+
+        auto textComp = textData.getData<TMPro::TextMeshProUGUI *>();
+        auto& rainbow = data.getData<RainbowData>();
+        // the tween is cancelled with the data once the text is unmounted
+        if (rainbow.text != textComp || rainbow.speed != speed) {
+            rainbow.text = textComp;
+            rainbow.speed = speed;
+            rainbow.tween = cycle(textComp);
         }
 
         return ret;
     }
 
     protected:
-        custom_types::Helpers::Coroutine rainbowCoroutine(RenderContext& ctx, RenderContextChildData& data) {
-            co_yield nullptr;
-
-#pragma clang diagnostic push
-#pragma ide diagnostic ignored "EndlessLoop"
-            while (true) {
-                if (!color && !*color) color = UnityEngine::Color(1.0f, 0.0f, 0.0f, 1.0f);
-
-                // https://forum.unity.com/threads/solved-rainbow-hue-shift-over-time-c-script.351751/#post-6651745
-                // Assign HSV values to float h, s & v. (Since data.color is stored in RGB)
+        struct RainbowData {
+            TMPro::TextMeshProUGUI* text = nullptr;
+            float speed = 0;
+            Tween tween;
+        };
+
+        Tween cycle(TMPro::TextMeshProUGUI* textComp) const {
+            UnityEngine::Color start(1.0f, 0.0f, 0.0f, 1.0f);
+            if (*color) {
                 float h, s, v;
-
-                Sombrero::ColorRGBToHSV(**color, h, s, v);
-
-                // Use HSV values to increase H in HSVToRGB. It looks like putting a value greater than 1 will round % 1 it
-                this->color = Sombrero::ColorHSVToRGB(h + UnityEngine::Time::get_deltaTime() * 0.25f * speed, s, v);
-
-                Text::render(ctx, ctx.getChildData(Text::key));
-
-                co_yield nullptr;
+                detail::rgbToHsv(**color, h, s, v);
+                // white and grey have no hue to cycle
+                if (s > 0) start = **color;
             }
-#pragma clang diagnostic pop
+
+            return Animator::hue(textComp, start, 1.0f, {.duration = 4.0f / speed, .repeat = Repeat::Loop});
         }
     };
-}
\ No newline at end of file
+}
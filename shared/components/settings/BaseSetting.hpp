@@ -3,10 +3,8 @@
 #include "UnityEngine/Vector2.hpp"
 
 #include "shared/concepts.hpp"
+#include "shared/function.hpp"
 #include "shared/RootContainer.hpp"
-#include "shared/components/HoverHint.hpp"
-
-#include "questui/shared/BeatSaberUI.hpp"
 
 #include <string>
 #include <utility>
@@ -16,7 +14,13 @@
 
 
 #include "UnityEngine/Transform.hpp"
+
+// only ConfigUtilsSetting needs QuestUI, the settings themselves build against any backend
+#if defined(AddConfigValue) || __has_include("config-utils/shared/config-utils.hpp")
+#include "shared/components/HoverHint.hpp"
+#include "questui/shared/BeatSaberUI.hpp"
 #include "config-utils/shared/config-utils.hpp"
+#endif
 
 namespace UnityEngine::UI {
     class Image;
@@ -105,7 +109,7 @@ namespace QUC {
         {t.getValue()} -> QUC::IsQUCConvertible<Value>;
 
         typename T::OnCallback;
-        IsQUCConvertible<typename T::OnCallback,std::function<void(T&, Value const&, UnityEngine::Transform *, RenderContext& ctx)>>;
+        requires IsQUCConvertible<typename T::OnCallback,std::function<void(T&, Value const&, UnityEngine::Transform *, RenderContext& ctx)>>;
     } && requires(T t, Value value) {
         {t.setValue(value)};
     };
@@ -143,6 +147,8 @@ namespace QUC {
 
         const Key key;
 
+        // the config value can change without going through QUC
+        static constexpr bool alwaysRender = true;
 
         UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
             SettingType::setValue(getValue());
@@ -164,11 +170,11 @@ namespace QUC {
 
         template<typename F, typename... TArgs>
         explicit ConfigUtilsSetting(ValueType currentValue, ConfigUtils::ConfigValue<ConfigValueType>& configValue, F&& callable, TArgs&&... args) :
-                configValue(configValue), SettingType(configValue.GetName(), buildCallback<F>(configValue, std::forward<F>(callable)), currentValue, args...) {}
+                configValue(configValue), SettingType(configValue.GetName(), buildCallback<F>(configValue, std::forward<F>(callable)), currentValue, std::forward<TArgs>(args)...) {}
 
         template<typename... TArgs>
         explicit ConfigUtilsSetting(ValueType currentValue, ConfigUtils::ConfigValue<ConfigValueType>& configValue, TArgs&&... args) :
-                configValue(configValue), SettingType(configValue.GetName(), buildCallback(configValue), currentValue, args...) {}
+                configValue(configValue), SettingType(configValue.GetName(), buildCallback(configValue), currentValue, std::forward<TArgs>(args)...) {}
 
         template<typename F = typename SettingType::OnCallback const&>
         static typename SettingType::OnCallback buildCallback(ConfigUtils::ConfigValue<ConfigValueType>& configValue, F&& callback) {
@@ -5,15 +5,17 @@
 #include "BaseSetting.hpp"
 
 #include "HMUI/SimpleTextDropdown.hpp"
-#include "System/Collections/Generic/IReadOnlyList_1.hpp"
+#include "TMPro/TextMeshProUGUI.hpp"
 
 #include "shared/context.hpp"
+#include "shared/backend.hpp"
 #include "shared/state.hpp"
 
-#include "questui/shared/BeatSaberUI.hpp"
-#include "config-utils/shared/config-utils.hpp"
 #include <string>
+#include <string_view>
 #include <array>
+#include <cstddef>
+#include <span>
 
 namespace QUC {
 
@@ -23,26 +25,35 @@ namespace QUC {
         struct RenderDropdownData {
             HMUI::SimpleTextDropdown* dropdown;
             TMPro::TextMeshProUGUI* uiText;
+            /// @brief Version of the values the dropdown shows
+            uint64_t valuesVersion;
         };
     public:
 
 //        static_assert(renderable<DropdownSetting>);
-        using OnCallback = std::function<void(DropdownSetting&, std::string const&, UnityEngine::Transform *, RenderContext& ctx)>;
-        HeldData<std::string> text;
+        using OnCallback = InlineFunction<void(DropdownSetting&, std::string const&, UnityEngine::Transform *, RenderContext& ctx)>;
+        ModifiedMask<5> modified;
+        TrackedData<std::string, DropdownSetting, 0> text;
         OnCallback callback;
-        HeldData<bool> enabled;
-        HeldData<bool> interactable;
-        HeldData<std::string> value;
-        HeldData<Container> values;
+        TrackedData<bool, DropdownSetting, 1> enabled;
+        TrackedData<bool, DropdownSetting, 2> interactable;
+        TrackedData<std::string, DropdownSetting, 3> value;
+        /// @brief Versioned, so changing a long list of values doesn't compare all of them
+        TrackedData<Versioned<Container>, DropdownSetting, 4> values;
 
         const Key key;
 
+        static constexpr size_t trackedOffset(size_t bit) {
+            return std::array{offsetof(DropdownSetting, text), offsetof(DropdownSetting, enabled), offsetof(DropdownSetting, interactable),
+                              offsetof(DropdownSetting, value), offsetof(DropdownSetting, values)}[bit];
+        }
+
         template<class F>
         constexpr DropdownSetting(std::string_view txt, std::string_view current, F &&callable,
                                   Container v = Container(), bool enabled_ = true,
                                   bool interact = true)
-                : text(txt), callback(callable), enabled(enabled_), interactable(interact), value(current),
-                  values(v) {}
+                : text(txt), callback(std::forward<F>(callable)), enabled(enabled_), interactable(interact), value(current),
+                  values(std::move(v)) {}
 
         UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
             auto& settingData = data.getData<RenderDropdownData>();
@@ -50,15 +61,15 @@ namespace QUC {
 
             auto parent = &ctx.parentTransform;
             if (!dropdown) {
-                auto cbk = [callback = this->callback, parent, &ctx, this](StringW val) mutable {
-                    value = static_cast<std::string>(val);
+                auto cbk = [parent, &ctx, this](std::string_view val) {
+                    value = val;
                     value.clear();
 
                     if (callback)
                         callback(*this, value.getData(), parent, ctx);
                 };
-                std::vector<StringW> nonsense(values.getData().begin(), values.getData().end());
-                dropdown = QuestUI::BeatSaberUI::CreateDropdown(parent, *text, *value, nonsense, cbk);
+                dropdown = QUC_NATIVE_CALL(Backend::createDropdown(parent, *text, *value, shownValues(), std::move(cbk)));
+                settingData.valuesVersion = values.getData().getVersion();
                 text.clear();
                 value.clear();
                 values.clear();
@@ -80,6 +91,9 @@ namespace QUC {
         }
 
         void update(RenderContext& ctx) {
+            // once per batch, see QUC::Batch
+            if (detail::BatchState::deferUpdate(*this, ctx)) return;
+
             auto& data = ctx.getChildData(key);
             auto& renderDropdownData = data.getData<RenderDropdownData>();
 
@@ -87,14 +101,25 @@ namespace QUC {
         }
 
     protected:
+        /// @brief The values, without copying them
+        std::span<std::string const> shownValues() const noexcept {
+            auto const& currentValues = values.getData().get();
+            return {std::data(currentValues), std::size(currentValues)};
+        }
+
         template<bool created>
         void assign(RenderDropdownData& renderDropdownData) {
+            QUC_PROFILE_SCOPE("DropdownSetting::assign");
             auto& dropdown = renderDropdownData.dropdown;
             auto& uiText = renderDropdownData.uiText;
             CRASH_UNLESS(dropdown);
 
+            if constexpr (!created) {
+                if (!modified.any()) return;
+            }
+
             if (enabled) {
-                dropdown->set_enabled(*enabled);
+                QUC_NATIVE_CALL(dropdown->set_enabled(*enabled));
                 enabled.clear();
             }
 
@@ -104,10 +129,10 @@ namespace QUC {
             }
 
             if constexpr (created) {
-                dropdown->button->set_interactable(*interactable);
+                QUC_NATIVE_CALL(dropdown->button->set_interactable(*interactable));
                 interactable.clear();
             } else if (interactable) {
-                dropdown->button->set_interactable(*interactable);
+                QUC_NATIVE_CALL(dropdown->button->set_interactable(*interactable));
                 interactable.clear();
             }
 
@@ -115,8 +140,7 @@ namespace QUC {
                 if (text) {
                     if (!uiText) {
                         // From QuestUI
-                        static auto labelName = il2cpp_utils::newcsstr<il2cpp_utils::CreationType::Manual>("Label");
-                        auto labelTransform = dropdown->get_transform()->get_parent()->Find(labelName);
+                        auto labelTransform = Backend::findChild(dropdown->get_transform()->get_parent(), "Label");
                         if (labelTransform) {
                             UnityEngine::GameObject *labelObject = labelTransform->get_gameObject();
                             if (labelObject) {
@@ -125,37 +149,32 @@ namespace QUC {
                         }
                     }
 
-                    uiText->set_text(il2cpp_utils::newcsstr(*text));
+                    QUC_NATIVE_CALL(Backend::setText(uiText, *text));
                     text.clear();
                 }
 
-                if (value || values) {
-                    List<StringW>* list = nullptr;
-
-                    if (values)
-                        list = List<StringW>::New_ctor();
+                // a copy of the shown values has the same version
+                bool valuesChanged = values && values.getData().getVersion() != renderDropdownData.valuesVersion;
+                if (value || valuesChanged) {
+                    if (valuesChanged) {
+                        QUC_NATIVE_CALL(Backend::setDropdownTexts(dropdown, shownValues()));
+                        renderDropdownData.valuesVersion = values.getData().getVersion();
+                    }
 
+                    auto currentValues = shownValues();
                     int selectedIndex = 0;
-                    for (int i = 0; i < values.getData().size(); i++) {
-                        std::string const &dropdownValue = values.getData()[i];
-                        if (value.getData() == dropdownValue) {
+                    for (int i = 0; i < currentValues.size(); i++) {
+                        if (value.getData() == currentValues[i]) {
                             selectedIndex = i;
                         }
-                        if (list)
-                            list->Add(dropdownValue);
-                    }
-
-                    if (list) {
-                        dropdown->SetTexts(
-                                reinterpret_cast<System::Collections::Generic::IReadOnlyList_1<StringW> *>(list));
                     }
 
                     if (dropdown->selectedIndex != selectedIndex)
                         dropdown->SelectCellWithIdx(selectedIndex);
 
                     value.clear();
-                    values.clear();
                 }
+                values.clear();
             }
         }
     };
@@ -254,7 +273,7 @@ template<> struct ::QUC::EnumStrValues<EnumName> {                      \
         explicit
         ConfigUtilsEnumDropdownSetting(ConfigUtils::ConfigValue<EnumConfigValue> &configValue, TArgs &&... args)
                 : configValue(configValue),
-                  SettingType(configValue.GetName(), "", buildCallback(configValue), EnumStrValues<EnumType>::values, args...) {
+                  SettingType(configValue.GetName(), "", buildCallback(configValue), EnumStrValues<EnumType>::values, std::forward<TArgs>(args)...) {
 
         }
 
@@ -262,7 +281,7 @@ template<> struct ::QUC::EnumStrValues<EnumName> {                      \
         explicit
         ConfigUtilsEnumDropdownSetting(ConfigUtils::ConfigValue<EnumConfigValue> &configValue, F&& callback, TArgs &&... args)
                 : configValue(configValue),
-                  SettingType(configValue.GetName(), "", buildCallback<F>(std::forward<F>(callback), configValue), EnumStrValues<EnumType>::values, args...) {
+                  SettingType(configValue.GetName(), "", buildCallback<F>(std::forward<F>(callback), configValue), EnumStrValues<EnumType>::values, std::forward<TArgs>(args)...) {
 
         }
 
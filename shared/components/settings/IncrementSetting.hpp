@@ -5,7 +5,10 @@
 #include "UnityEngine/Vector2.hpp"
 
 #include "shared/context.hpp"
+#include "shared/backend.hpp"
 #include "questui/shared/BeatSaberUI.hpp"
+#include <array>
+#include <cstddef>
 #include <string>
 
 namespace QUC {
@@ -17,22 +20,29 @@ namespace QUC {
         };
     public:
 
-        using OnCallback = std::function<void(IncrementSetting&, float, UnityEngine::Transform*, RenderContext& ctx)>;
-        HeldData<std::string> text;
+        using OnCallback = InlineFunction<void(IncrementSetting&, float, UnityEngine::Transform*, RenderContext& ctx)>;
+        ModifiedMask<8> modified;
+        TrackedData<std::string, IncrementSetting, 0> text;
         OnCallback callback;
-        HeldData<bool> enabled;
-        HeldData<bool> interactable;
-        HeldData<float> value;
-        HeldData<int> decimals;
-        HeldData<float> increment;
-        HeldData<std::optional<float>> min;
-        HeldData<std::optional<float>> max;
+        TrackedData<bool, IncrementSetting, 1> enabled;
+        TrackedData<bool, IncrementSetting, 2> interactable;
+        TrackedData<float, IncrementSetting, 3> value;
+        TrackedData<int, IncrementSetting, 4> decimals;
+        TrackedData<float, IncrementSetting, 5> increment;
+        TrackedData<std::optional<float>, IncrementSetting, 6> min;
+        TrackedData<std::optional<float>, IncrementSetting, 7> max;
         const UnityEngine::Vector2 anchoredPosition;
         const Key key;
 
+        static constexpr size_t trackedOffset(size_t bit) {
+            return std::array{offsetof(IncrementSetting, text), offsetof(IncrementSetting, enabled), offsetof(IncrementSetting, interactable),
+                              offsetof(IncrementSetting, value), offsetof(IncrementSetting, decimals), offsetof(IncrementSetting, increment),
+                              offsetof(IncrementSetting, min), offsetof(IncrementSetting, max)}[bit];
+        }
+
         template<class F>
         IncrementSetting(std::string_view txt, F&& callable, float currentValue = 0.0f, int decimals_ = 1, float increment = 1.0f, std::optional<float> min_ = std::nullopt, std::optional<float> max_ = std::nullopt,  bool enabled_ = true, bool interact = true, UnityEngine::Vector2 anch = {})
-            : text(txt), callback(callable), enabled(enabled_), interactable(interact), value(currentValue), increment(increment), decimals(decimals_), min(min_), max(max_), anchoredPosition(anch) {}
+            : text(txt), callback(std::forward<F>(callable)), enabled(enabled_), interactable(interact), value(currentValue), increment(increment), decimals(decimals_), min(min_), max(max_), anchoredPosition(anch) {}
 
         UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
             auto &settingData = data.getData<RenderIncrementSetting>();
@@ -41,7 +51,7 @@ namespace QUC {
             auto parent = &ctx.parentTransform;
             if (!setting) {
                 auto cbk = std::function<void(float)>(
-                        [callback = this->callback, parent, &ctx, this](float val) mutable {
+                        [parent, &ctx, this](float val) {
                             value = val;
                             value.clear();
 
@@ -49,7 +59,7 @@ namespace QUC {
                                 callback(*this, val, parent, ctx);
                         });
 
-                setting = QuestUI::BeatSaberUI::CreateIncrementSetting(
+                setting = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateIncrementSetting(
                         parent,
                         *text,
                         *decimals,
@@ -60,7 +70,7 @@ namespace QUC {
                         min.getData().value_or(0.0f),
                         max.getData().value_or(0.0f),
                         anchoredPosition,
-                        cbk);
+                        cbk));
 
                 assign<true>(settingData);
             } else {
@@ -80,6 +90,9 @@ namespace QUC {
         }
 
         void update(RenderContext& ctx) {
+            // once per batch, see QUC::Batch
+            if (detail::BatchState::deferUpdate(*this, ctx)) return;
+
             auto& data = ctx.getChildData(key);
             auto& inputFieldView = data.getData<RenderIncrementSetting>();
 
@@ -89,12 +102,17 @@ namespace QUC {
     protected:
         template<bool created = false>
         void assign(RenderIncrementSetting& renderIncrementSetting) {
+            QUC_PROFILE_SCOPE("IncrementSetting::assign");
             auto setting = renderIncrementSetting.setting;
             auto& textSetting = renderIncrementSetting.textSetting;
             CRASH_UNLESS(setting);
 
+            if constexpr (!created) {
+                if (!modified.any()) return;
+            }
+
             if (enabled) {
-                setting->set_enabled(*enabled);
+                QUC_NATIVE_CALL(setting->set_enabled(*enabled));
                 enabled.clear();
             }
 
@@ -106,37 +124,42 @@ namespace QUC {
             // TODO: Interactable
 
             if constexpr(!created) {
-
-                if (text) {
-                    if (!textSetting)
-                        textSetting = setting->GetComponentInChildren<TMPro::TextMeshProUGUI *>();
-
-                    CRASH_UNLESS(textSetting);
-                    textSetting->set_text(il2cpp_utils::newcsstr(*text));
-                    text.clear();
-                }
-                if (decimals) {
-                    setting->Decimals = *decimals;
-                    decimals.clear();
-                }
-                if (increment) {
-                    setting->Increment = *increment;
-                    increment.clear();
-                }
-                if (max) {
-                    setting->MaxValue = max.getData().value_or(0);
-                    setting->HasMax = static_cast<bool>(max.getData());
-                    max.clear();
-                }
-                if (min) {
-                    setting->MinValue = min.getData().value_or(0);
-                    setting->HasMin = static_cast<bool>(min.getData());
-                    min.clear();
-                }
-
-                if (value) {
+                // value last, so it is checked against the new bounds
+                bool valueModified = value.isModified();
+                value.clear();
+
+                modified.forEach([&](size_t bit) {
+                    switch (bit) {
+                        case decltype(text)::index:
+                            if (!textSetting)
+                                textSetting = setting->GetComponentInChildren<TMPro::TextMeshProUGUI *>();
+
+                            CRASH_UNLESS(textSetting);
+                            QUC_NATIVE_CALL(Backend::setText(textSetting, *text));
+                            break;
+                        case decltype(decimals)::index:
+                            setting->Decimals = *decimals;
+                            break;
+                        case decltype(increment)::index:
+                            setting->Increment = *increment;
+                            break;
+                        case decltype(min)::index:
+                            setting->MinValue = min.getData().value_or(0);
+                            setting->HasMin = static_cast<bool>(min.getData());
+                            break;
+                        case decltype(max)::index:
+                            setting->MaxValue = max.getData().value_or(0);
+                            setting->HasMax = static_cast<bool>(max.getData());
+                            break;
+                        default:
+                            break;
+                    }
+                });
+                // interactable isn't applied yet either
+                modified.clear();
+
+                if (valueModified) {
                     setting->CurrentValue = *value;
-                    value.clear();
                 }
             }
         }
@@ -5,6 +5,7 @@
 
 #include "BaseSetting.hpp"
 #include "shared/context.hpp"
+#include "shared/backend.hpp"
 #include "questui/shared/BeatSaberUI.hpp"
 #include "HMUI/InputFieldView.hpp"
 
@@ -12,7 +13,7 @@
 
 namespace QUC {
     struct StringSetting {
-        using OnCallback = std::function<void(StringSetting&, std::string const&, UnityEngine::Transform*, RenderContext& ctx)>;
+        using OnCallback = InlineFunction<void(StringSetting&, std::string const&, UnityEngine::Transform*, RenderContext& ctx)>;
         HeldData<std::string> text;
         OnCallback callback;
         HeldData<bool> enabled;
@@ -25,22 +26,22 @@ namespace QUC {
 
         template<class F>
         constexpr StringSetting(std::string_view txt, F&& callable, std::string_view currentValue = "", bool enabled_ = true, bool interact = true, UnityEngine::Vector2 anch = {}, UnityEngine::Vector3 offt = {})
-            : text(txt), callback(callable), enabled(enabled_), interactable(interact), value(currentValue), anchoredPosition(anch), keyboardPositionOffset(offt) {}
+            : text(txt), callback(std::forward<F>(callable)), enabled(enabled_), interactable(interact), value(currentValue), anchoredPosition(anch), keyboardPositionOffset(offt) {}
 
         UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
             auto& inputFieldView = data.getData<HMUI::InputFieldView*>();
             // TODO: Cache this properly
             auto parent = &ctx.parentTransform;
             if (!inputFieldView) {
-                auto cbk = [callback = this->callback, parent, &ctx, this](StringW val)mutable {
+                auto cbk = [parent, &ctx, this](StringW val) {
                     value = static_cast<std::string>(val);
                     value.clear();
                     if (callback)
                         callback(*this, value.getData(), parent, ctx);
                 };
-                inputFieldView = QuestUI::BeatSaberUI::CreateStringSetting(parent, *text, *value, anchoredPosition,
-                                                                           keyboardPositionOffset,
-                                                                           cbk);
+                inputFieldView = QUC_NATIVE_CALL(QuestUI::BeatSaberUI::CreateStringSetting(parent, *text, *value, anchoredPosition,
+                                                                                           keyboardPositionOffset,
+                                                                                           cbk));
                 assign<true>(inputFieldView);
             } else {
                 assign<false>(inputFieldView);
@@ -58,6 +59,9 @@ namespace QUC {
         }
 
         void update(RenderContext& ctx) {
+            // once per batch, see QUC::Batch
+            if (detail::BatchState::deferUpdate(*this, ctx)) return;
+
             auto& data = ctx.getChildData(key);
             auto& inputFieldView = data.getData<HMUI::InputFieldView*>();
 
@@ -67,9 +71,10 @@ namespace QUC {
     private:
         template<bool created>
         void assign(HMUI::InputFieldView* inputFieldView) {
+            QUC_PROFILE_SCOPE("StringSetting::assign");
             CRASH_UNLESS(inputFieldView);
             if (enabled) {
-                inputFieldView->set_enabled(*enabled);
+                QUC_NATIVE_CALL(inputFieldView->set_enabled(*enabled));
                 enabled.clear();
             }
 
@@ -79,10 +84,10 @@ namespace QUC {
             }
 
             if constexpr (created) {
-                inputFieldView->set_interactable(*interactable);
+                QUC_NATIVE_CALL(inputFieldView->set_interactable(*interactable));
                 interactable.clear();
             } else if (interactable) {
-                inputFieldView->set_interactable(*interactable);
+                QUC_NATIVE_CALL(inputFieldView->set_interactable(*interactable));
                 interactable.clear();
             }
 
@@ -90,12 +95,12 @@ namespace QUC {
                 if (text) {
                     auto txt = inputFieldView->placeholderText->GetComponent<TMPro::TextMeshProUGUI *>();
                     CRASH_UNLESS(txt);
-                    txt->set_text(il2cpp_utils::newcsstr(*text));
+                    QUC_NATIVE_CALL(Backend::setText(txt, *text));
                     text.clear();
                 }
 
                 if (value) {
-                    inputFieldView->SetText(il2cpp_utils::newcsstr(*value));
+                    QUC_NATIVE_CALL(inputFieldView->SetText(ManagedStrings::get(*value)));
                 }
             }
         }
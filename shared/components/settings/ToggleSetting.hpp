@@ -3,18 +3,20 @@
 #include "UnityEngine/Vector2.hpp"
 
 #include "shared/context.hpp"
-
-#include "questui/shared/BeatSaberUI.hpp"
-#include "beatsaber-hook/shared/utils/utils.h"
+#include "shared/pool.hpp"
+#include "shared/backend.hpp"
+#include "shared/function.hpp"
 
 #include <string>
 #include <string_view>
 #include <functional>
 
 #include "BaseSetting.hpp"
+#include "shared/components/Text.hpp"
 
 #include "TMPro/TextMeshProUGUI.hpp"
 #include "UnityEngine/UI/Toggle.hpp"
+#include "UnityEngine/RectTransform.hpp"
 
 namespace QUC {
     struct ToggleSetting {
@@ -27,18 +29,19 @@ namespace QUC {
         protected:
             template<bool created = false>
             void assign(UnityEngine::UI::Toggle* toggle) {
+                QUC_PROFILE_SCOPE("ToggleSetting::ToggleButton::assign");
                 if constexpr (!created) {
                     // Only set these properties if we did NOT JUST create the text.
                     if (value) {
-                        toggle->set_isOn(*value);
+                        QUC_NATIVE_CALL(toggle->set_isOn(*value));
                         value.clear();
                     }
                 }
                 if constexpr (created) {
-                    toggle->set_interactable(*interactable);
+                    QUC_NATIVE_CALL(toggle->set_interactable(*interactable));
                     interactable.clear();
                 } else if (interactable) {
-                    toggle->set_interactable(*interactable);
+                    QUC_NATIVE_CALL(toggle->set_interactable(*interactable));
                     interactable.clear();
                 }
             }
@@ -51,6 +54,7 @@ namespace QUC {
             ToggleText() = default;
 
             ToggleText(ToggleText const& text) = default;
+            ToggleText(ToggleText&&) = default;
 
             ToggleText(Text const& text) : Text(text) {}
 
@@ -68,7 +72,7 @@ namespace QUC {
             friend class ToggleSetting;
         };
 
-        using OnCallback = std::function<void(ToggleSetting&, bool, UnityEngine::Transform*, RenderContext& ctx)>;
+        using OnCallback = InlineFunction<void(ToggleSetting&, bool, UnityEngine::Transform*, RenderContext& ctx)>;
         const OnCallback callback;
         HeldData<bool> enabled;
 
@@ -88,11 +92,11 @@ namespace QUC {
 
         template<class F = OnCallback>
         ToggleSetting(Text const& txt, F&& callable, bool currentValue = false, bool enabled_ = true, bool interact = true, std::optional<UnityEngine::Vector2> anch = std::nullopt)
-                : text(txt), callback(callable), enabled(enabled_), toggleButton(currentValue, interact), anchoredPosition(anch) {}
+                : text(txt), callback(std::forward<F>(callable)), enabled(enabled_), toggleButton(currentValue, interact), anchoredPosition(anch) {}
 
         template<class F = OnCallback>
         ToggleSetting(std::string_view txt, F&& callable, bool currentValue = false, bool enabled_ = true, bool interact = true, std::optional<UnityEngine::Vector2> anch = std::nullopt)
-                : text(txt), callback(callable), enabled(enabled_), toggleButton(currentValue, interact), anchoredPosition(anch) {}
+                : text(txt), callback(std::forward<F>(callable)), enabled(enabled_), toggleButton(currentValue, interact), anchoredPosition(anch) {}
 
         UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
             auto& toggle = data.getData<UnityEngine::UI::Toggle*>();
@@ -102,22 +106,28 @@ namespace QUC {
             if (!toggle) {
                 auto const &usableText = *text.text;
 
-                auto cbk = [this, callback = this->callback, parent, &ctx](bool val) {
+                auto cbk = [this, parent, &ctx](bool val) {
                     toggleButton.value = val;
                     toggleButton.value.clear();
                     if (callback)
                         callback(*this, val, parent, ctx);
                 };
-                if (anchoredPosition) {
-                    toggle = QuestUI::BeatSaberUI::CreateToggle(parent, usableText, *toggleButton.value, *anchoredPosition, cbk);
-                } else {
-                    toggle = QuestUI::BeatSaberUI::CreateToggle(parent, usableText, *toggleButton.value, cbk);
+
+                // CreateToggle only sets the position when given one
+                size_t variant = anchoredPosition ? 1 : 0;
+                if (auto pooled = NativePool<ToggleSetting>::acquire(parent, variant)) {
+                    toggle = pooled->GetComponentInChildren<UnityEngine::UI::Toggle*>();
+                    toggleText = findNameText(toggle);
+                    NativePool<ToggleSetting>::track(data, pooled, variant);
+                    reuse(toggle, toggleText, std::function<void(bool)>(cbk));
+                    return toggle->get_transform();
                 }
 
-                auto nameTextTransform = CRASH_UNLESS(toggle->get_transform()->get_parent()->Find(il2cpp_utils::newcsstr("NameText")));
-                auto nameText = nameTextTransform->get_gameObject();
-                CRASH_UNLESS(nameText);
-                toggleText = nameText->GetComponent<TMPro::TextMeshProUGUI *>();
+                toggle = QUC_NATIVE_CALL(Backend::createToggle(parent, usableText, *toggleButton.value, anchoredPosition, cbk));
+
+                toggleText = findNameText(toggle);
+                // the toggle is nested in the object CreateToggle made
+                NativePool<ToggleSetting>::track(data, toggle->get_transform()->get_parent()->get_gameObject(), variant);
 
                 // if text was not created
                 text.text.clear();
@@ -132,6 +142,9 @@ namespace QUC {
         }
 
         void update(RenderContext& ctx) {
+            // once per batch, see QUC::Batch
+            if (detail::BatchState::deferUpdate(*this, ctx)) return;
+
             auto& data = ctx.getChildData(key);
             auto& toggle = data.getData<UnityEngine::UI::Toggle*>();
             auto& cachedToggleText = ctx.getChildData(text.key).getData<TMPro::TextMeshProUGUI*>();
@@ -140,11 +153,43 @@ namespace QUC {
         }
 
     protected:
+        static TMPro::TextMeshProUGUI* findNameText(UnityEngine::UI::Toggle* toggle) {
+            auto nameTextTransform = CRASH_UNLESS(Backend::findChild(toggle->get_transform()->get_parent(), "NameText"));
+            auto nameText = nameTextTransform->get_gameObject();
+            CRASH_UNLESS(nameText);
+            return nameText->GetComponent<TMPro::TextMeshProUGUI *>();
+        }
+
+        /// @brief Rebinds a toggle taken from the pool, replacing the listener of its previous owner
+        void reuse(UnityEngine::UI::Toggle* toggle, TMPro::TextMeshProUGUI* toggleText, std::function<void(bool)> callback) {
+            CRASH_UNLESS(toggle);
+            CRASH_UNLESS(toggleText);
+
+            // set the value before listening, so the new owner isn't called back for it
+            QUC_NATIVE_CALL(Backend::setOnValueChanged(toggle, nullptr));
+            QUC_NATIVE_CALL(toggle->set_isOn(*toggleButton.value));
+            toggleButton.value.clear();
+            QUC_NATIVE_CALL(Backend::setOnValueChanged(toggle, std::move(callback)));
+
+            if (anchoredPosition) {
+                toggle->get_transform()->get_parent()->GetComponent<UnityEngine::RectTransform *>()->set_anchoredPosition(*anchoredPosition);
+            }
+
+            QUC_NATIVE_CALL(Backend::setText(toggleText, *text.text));
+            text.text.clear();
+
+            QUC_NATIVE_CALL(toggle->set_enabled(*enabled));
+            enabled.clear();
+            toggleButton.assign<true>(toggle);
+            assign<true>(toggle, toggleText);
+        }
+
         template<bool created = false>
         void assign(UnityEngine::UI::Toggle* toggle, TMPro::TextMeshProUGUI* toggleText) {
+            QUC_PROFILE_SCOPE("ToggleSetting::assign");
             CRASH_UNLESS(toggle);
             if (enabled) {
-                toggle->set_enabled(*enabled);
+                QUC_NATIVE_CALL(toggle->set_enabled(*enabled));
                 enabled.clear();
             }
 
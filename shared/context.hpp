@@ -1,11 +1,26 @@
 #pragma once
 
 #include "key.hpp"
+#include "KeyMap.hpp"
 #include "UnsafeAny.hpp"
+#include "profiler.hpp"
+#include "dirty.hpp"
+#include "batch.hpp"
+#include "mutations.hpp"
+#include "backend.hpp"
 
 #include <concepts>
 #include <tuple>
+#include <array>
 #include <any>
+#include <memory_resource>
+#include <chrono>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <span>
+#include <unordered_set>
 
 #include "UnityEngine/GameObject.hpp"
 #include "UnityEngine/Transform.hpp"
@@ -14,15 +29,84 @@ namespace QUC {
 
     struct RenderContext;
 
+    template<typename RenderContextT>
+    struct RenderContextChildDataT;
+
+    namespace detail {
+        /// @brief Positional cache of child data for containers with a fixed amount of children.
+        /// Slot N points to the data of the Nth child, so re-rendering skips the keyed lookup.
+        template<size_t sz, typename RenderContextT = RenderContext>
+        struct ChildSlots {
+            RenderContextT const* ctx = nullptr;
+            size_t generation = 0;
+            std::array<RenderContextChildDataT<RenderContextT>*, sz> slots{};
+
+            [[nodiscard]] constexpr bool isValidFor(RenderContextT const& other) const noexcept {
+                return ctx == &other && generation == other.getGeneration();
+            }
+        };
+    }
+
+    namespace detail {
+        inline void forgetComponent(void const* data) noexcept;
+    }
+
+    /// @brief A native object that is handed to a pool instead of being destroyed, see NativePool
+    struct PooledObject {
+        UnityEngine::GameObject* object = nullptr;
+        size_t variant = 0;
+        void(*release)(UnityEngine::GameObject* object, size_t variant) = nullptr;
+    };
+
     template<typename RenderContextT = RenderContext>
     struct RenderContextChildDataT {
+        RenderContextChildDataT() = default;
+        explicit RenderContextChildDataT(std::pmr::memory_resource* resource) : resource(resource) {}
+
+        ~RenderContextChildDataT() {
+            if (component) detail::forgetComponent(this);
+        }
+
         UnsafeAny childData;
         std::optional<RenderContextT> childContext;
-
+        /// @brief Used by static containers to cache the data of their children
+        UnsafeAny childSlots;
+        /// @brief The transform returned by the last render, if the component returns one
+        UnityEngine::Transform* transform = nullptr;
+        /// @brief Epoch of the owning context when this data was last used, see RenderContext::sweep
+        uint32_t lastVisit = 0;
+        /// @brief Where state and child contexts are allocated from, inherited from the owning context
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+        /// @brief Set by components whose native object can be reused after being unmounted
+        PooledObject pooled;
+
+        // Dirty tracking, see detail::DirtyTracker
+        /// @brief Data of the component that rendered this one
+        RenderContextChildDataT* parent = nullptr;
+        /// @brief Address and size of the component last rendered with this data
+        void const* component = nullptr;
+        size_t componentSize = 0;
+        /// @brief DirtyTracker::version at the last render
+        uint32_t cleanVersion = 0;
+        /// @brief Held data of the component or one of its descendants changed since its last render
+        bool dirty = true;
+        /// @brief The component rendered children into its own context on its last render.
+        /// Skipping it would leave them unvisited, and sweep() would remove them.
+        bool sharesContext = false;
+        /// @brief The component or one of its descendants renders on every pass (see always_render),
+        /// so it can't be skipped either
+        bool rendersAlways = false;
+
+        /// @brief The state of the component, created on first use.
+        /// State that takes an allocator (std::pmr containers, KeyedList) allocates from resource as well.
         template<typename T>
         T& getData() {
             if (!childData.has_value()) {
-                return childData.make_any<T>();
+                if constexpr (std::uses_allocator_v<T, std::pmr::polymorphic_allocator<std::byte>>) {
+                    return childData.make_any_with<T>(resource, std::pmr::polymorphic_allocator<std::byte>(resource));
+                } else {
+                    return childData.make_any_with<T>(resource);
+                }
             }
             return childData.get_any<T>();
         }
@@ -30,21 +114,88 @@ namespace QUC {
         template<typename F = std::function<UnityEngine::Transform*()>>
         constexpr RenderContextT& getChildContext(F transform) {
             if (!childContext) {
-                return childContext.template emplace(transform());
+                return childContext.template emplace(transform(), resource);
             }
 
             return *childContext;
         }
+
+        template<size_t sz>
+        detail::ChildSlots<sz, RenderContextT>& getChildSlots() {
+            if (!childSlots.has_value()) {
+                return childSlots.make_any_with<detail::ChildSlots<sz, RenderContextT>>(resource);
+            }
+            return childSlots.get_any<detail::ChildSlots<sz, RenderContextT>>();
+        }
     };
 
     using RenderContextChildData = RenderContextChildDataT<RenderContext>;
 
+    namespace detail {
+        /// @brief Progress of an incremental mount, see mountIncrementally.
+        /// Components are created level by level: a pass only creates components up to the frontier depth,
+        /// and only as many as the frame budget allows. Children of containers that couldn't be created are
+        /// skipped, and their ancestors stay dirty so the next pass continues where this one stopped.
+        struct MountState {
+            using Clock = std::chrono::steady_clock;
+
+            size_t maxCreates;
+            Clock::duration maxTime;
+
+            /// @brief Deepest level that may be created
+            uint32_t frontier = 1;
+            size_t created = 0;
+            Clock::time_point frameStart;
+            /// @brief A component within the frontier couldn't be created, because the frame budget ran out
+            bool blocked = false;
+            /// @brief A component beyond the frontier wasn't created
+            bool deferred = false;
+            bool cancelled = false;
+
+            /// @brief The mount of the render pass in progress
+            inline static MountState* active = nullptr;
+
+            void startFrame() {
+                created = 0;
+                frameStart = Clock::now();
+            }
+
+            void beginPass() noexcept {
+                blocked = false;
+                deferred = false;
+                active = this;
+            }
+
+            void endPass() noexcept {
+                active = nullptr;
+            }
+
+            [[nodiscard]] bool isComplete() const noexcept {
+                return !blocked && !deferred;
+            }
+
+            bool mayCreate(uint32_t depth) {
+                if (depth > frontier) {
+                    deferred = true;
+                    return false;
+                }
+                if (created >= maxCreates || Clock::now() - frameStart >= maxTime) {
+                    blocked = true;
+                    return false;
+                }
+                return true;
+            }
+        };
+    }
+
     struct RenderContext {
         using ChildContextKey = Key; // 64 bit number
         using ChildData = Il2CppObject*;
 
         /// @brief The parent transform to render on to.
         UnityEngine::Transform& parentTransform;
+        /// @brief Set while the tree rendered on this context is mounted incrementally
+        detail::MountState* mountState = nullptr;
 
         // For now, if we ever need to trigger a rebuild we simply say that we need to on the component side.
         // Alternatively, any time we show a component, we call render, which will generate what we need and set everything accordingly.
@@ -53,38 +204,131 @@ namespace QUC {
         RenderContext(UnityEngine::Transform* ptr) : parentTransform(*ptr) {}
         RenderContext(UnityEngine::Transform& ref) : parentTransform(ref) {}
 
+        /// @brief All child data, state and child contexts of this tree will be allocated from resource.
+        /// Using a pool (e.g. std::pmr::unsynchronized_pool_resource) per view keeps its bookkeeping in a few large blocks,
+        /// which can be freed all at once with release() after destroyTree().
+        /// The resource must outlive the context.
+        RenderContext(UnityEngine::Transform* ptr, std::pmr::memory_resource* resource) : parentTransform(*ptr), dataContext(resource) {}
+        RenderContext(UnityEngine::Transform& ref, std::pmr::memory_resource* resource) : parentTransform(ref), dataContext(resource) {}
+
         RenderContext(RenderContext&&) = default;
 
         RenderContext& operator=(RenderContext&& other) {
-            new (this) RenderContext(std::move(other));
+            if (this != &other) {
+                this->~RenderContext();
+                new (this) RenderContext(std::move(other));
+            }
             return *this;
         }
 
         auto& getChildData(ChildContextKey index) {
-            return dataContext[index];
+            auto& data = dataContext[index];
+            markVisited(data);
+            return data;
+        }
+
+        /// @brief Makes room for the data of n children, so a context rendered for the first time allocates it at once
+        void reserveChildren(size_t n) {
+            dataContext.reserve(n);
+        }
+
+        /// @brief Marks child data as used in the current render pass, so sweep() keeps it around.
+        constexpr void markVisited(RenderContextChildData& data) noexcept {
+            data.lastVisit = epoch;
+            visitedSinceSweep = true;
+        }
+
+        /// @brief Removes child data that hasn't been used in the last maxAge sweeps
+        /// or whose native objects were destroyed outside of QUC.
+        /// Call this right after rendering the whole tree of this context.
+        /// Child contexts are swept recursively, unless nothing rendered into them since their last sweep.
+        /// @tparam destroyGO Also destroys the native objects of removed child data
+        /// @param maxAge Amount of sweeps child data may go unused before being removed
+        /// @return The amount of removed child data in this context and its child contexts
+        template<bool destroyGO = false>
+        size_t sweep(uint32_t maxAge = 1) {
+            if (!visitedSinceSweep) return 0;
+            visitedSinceSweep = false;
+
+            size_t childrenRemoved = 0;
+            size_t removed = dataContext.eraseIf([&](ChildContextKey const&, RenderContextChildData& data) {
+                bool transformDead = data.transform && !data.transform->m_CachedPtr;
+                bool contextDead = data.childContext && !data.childContext->parentTransform.m_CachedPtr;
+
+                if (!transformDead && !contextDead && epoch - data.lastVisit < maxAge) {
+                    if (data.childContext)
+                        childrenRemoved += data.childContext->template sweep<destroyGO>(maxAge);
+                    return false;
+                }
+
+                if constexpr (destroyGO) {
+                    destroyNative(data);
+                }
+                return true;
+            });
+
+            if (removed > 0) generation++;
+            epoch++;
+
+            return removed + childrenRemoved;
+        }
+
+        [[nodiscard]] std::pmr::memory_resource* getResource() const noexcept {
+            return dataContext.getResource();
+        }
+
+        /// @brief Incremented whenever child data is removed.
+        /// References to child data stay valid for as long as the generation doesn't change.
+        [[nodiscard]] size_t getGeneration() const noexcept {
+            return generation;
         }
 
 #pragma region child Context Clutter
         void destroyChildContext(ChildContextKey id) {
-            auto contextIt = dataContext.find(id);
-            if (contextIt == dataContext.end()) return;
+            auto contextPtr = dataContext.find(id);
+            if (!contextPtr) return;
 
-            auto& context = contextIt->second;
+            auto& context = *contextPtr;
 
             if (!context.childContext)
                 return;
 
-            auto const& data = *context.childContext;
-            if (data.parentTransform.m_CachedPtr) {
-                // Destroy old context tree
-                UnityEngine::Object::Destroy(data.parentTransform.get_gameObject());
-            }
+            // Destroy old context tree
+            destroyNative(context);
 
-
-            dataContext.erase(contextIt);
+            dataContext.erase(id);
+            generation++;
         }
 #pragma endregion
 
+        /// @brief Hands the native object of data back to its pool, after doing the same for everything rendered into it.
+        /// Children that aren't pooled are destroyed, since the pooled object is reused later on.
+        /// @return true if the native object is now owned by a pool
+        static bool releaseToPool(RenderContextChildData& data) {
+            if (data.childContext)
+                data.childContext->destroyTree();
+
+            auto& pooled = data.pooled;
+            if (!pooled.object || !pooled.object->m_CachedPtr)
+                return false;
+
+            pooled.release(pooled.object, pooled.variant);
+            pooled = {};
+            return true;
+        }
+
+        /// @brief Pools or destroys the native objects of data
+        static void destroyNative(RenderContextChildData& data) {
+            if (releaseToPool(data))
+                return;
+
+            if (data.transform && data.transform->m_CachedPtr)
+                QUC_NATIVE_CALL(Backend::destroy(data.transform->get_gameObject()));
+
+            if (data.childContext && &data.childContext->parentTransform != data.transform && data.childContext->parentTransform.m_CachedPtr)
+                QUC_NATIVE_CALL(Backend::destroy(data.childContext->parentTransform.get_gameObject()));
+        }
+
         template<bool includeParent = false>
         void destroyTree() {
             // yeah yeah I know stupid
@@ -94,41 +338,50 @@ namespace QUC {
                 return;
 #pragma clang diagnostic pop
 
+            if (mountState) {
+                mountState->cancelled = true;
+                mountState = nullptr;
+            }
+
+            // Pooled objects are moved out of the tree first so they survive it being destroyed
+            dataContext.forEach([](ChildContextKey const&, RenderContextChildData& data) {
+                releaseToPool(data);
+            });
+
             if (parentTransform.m_CachedPtr) {
                 if constexpr (includeParent) {
-                    UnityEngine::Object::Destroy(parentTransform.get_gameObject());
+                    QUC_NATIVE_CALL(Backend::destroy(parentTransform.get_gameObject()));
                 } else {
-                    int childCount = parentTransform.GetChildCount();
-                    std::vector<UnityEngine::Transform*> transforms;
-                    for (int i = 0; i < childCount; i++) {
-                        auto transform = parentTransform.GetChild(i);
-                        transforms.emplace_back(transform);
-                    }
-                    for (auto transform :transforms) {
-                        UnityEngine::Object::Destroy(transform->get_gameObject());
+                    // back to front, so it works whether destroying detaches the child right away or at the end of the frame
+                    for (int i = parentTransform.GetChildCount(); i-- > 0;) {
+                        QUC_NATIVE_CALL(Backend::destroy(parentTransform.GetChild(i)->get_gameObject()));
                     }
                 }
             }
-            dataContext.clear();
+            // gives the memory back too, so the resource can be released after this
+            dataContext.release();
+            generation++;
         }
 
         template<bool destroyGO = true>
         void destroyChild(ChildContextKey key) {
-            auto it = dataContext.find(key);
-            if (it == dataContext.end()) return;
+            auto data = dataContext.find(key);
+            if (!data) return;
 
-            auto& o = it->second.childContext;
-
-            if (o && o->parentTransform.m_CachedPtr)
-                UnityEngine::Object::Destroy(&o->parentTransform);
+            if constexpr (destroyGO) {
+                destroyNative(*data);
+            }
 
-            dataContext.erase(it);
+            dataContext.erase(key);
+            generation++;
         }
 
 
     private:
-        // TODO: Figure out cleaning unusued keys
-        std::unordered_map<ChildContextKey, RenderContextChildData> dataContext;
+        KeyMap<RenderContextChildData> dataContext;
+        size_t generation = 0;
+        uint32_t epoch = 1;
+        bool visitedSinceSweep = false;
     };
 
     // Allows both copies and references
@@ -165,12 +418,240 @@ namespace QUC {
 //        {t.clone()} -> std::same_as<T>;
     };
 
+    template<class T>
+    /// @brief Components that read state other than their HeldData on render (e.g. a config value)
+    /// declare `static constexpr bool alwaysRender = true;` so they are never skipped.
+    concept always_render = requires {
+        requires T::alwaysRender;
+    };
+
     namespace detail {
+        /// @brief Something components depend on when they read it during render, see Signal.
+        /// Told when a component that read it is forgotten, so it stops rendering it again.
+        struct Dependency {
+            virtual void forgetReader(RenderContextChildData const& reader) noexcept = 0;
+
+        protected:
+            ~Dependency() = default;
+        };
+
+        /// @brief Finds which components were modified, so rendering a tree again only visits those and their ancestors.
+        /// Every rendered component registers the memory it occupies. Writes to HeldData record their address
+        /// (see PendingWrites), and the outermost renderSingle resolves them to the innermost component containing
+        /// that address, then marks it and every component above it dirty.
+        /// Writes outside of any rendered component are ignored: a component that isn't rendered yet, or was copied or
+        /// moved since its last render, is rendered in full the next time it's reached anyway.
+        /// Only writes that got lost (see PendingWrites::capacity) make the next render visit everything.
+        /// Only used from the render thread.
+        struct DirtyTracker {
+            struct Frame {
+                RenderContextChildData* data;
+                RenderContext* ctx;
+                Frame* parent;
+                uint32_t depth;
+                /// @brief Renders the component of data on its own, as the outermost component
+                void (*render)(void* component, RenderContext& ctx);
+            };
+
+            /// @brief The component currently rendering
+            inline static Frame* current = nullptr;
+            /// @brief Data rendered with an older version is rendered again
+            inline static uint32_t version = 1;
+
+            static void track(RenderContextChildData& data, void const* component, size_t size) {
+                if (data.component == component && data.componentSize == size) return;
+                if (data.component) forget(data);
+
+                auto begin = reinterpret_cast<uintptr_t>(component);
+                ranges[{begin, begin + size}] = &data;
+                live.insert(&data);
+                data.component = component;
+                data.componentSize = size;
+            }
+
+            static void forget(RenderContextChildData const& data) noexcept {
+                auto begin = reinterpret_cast<uintptr_t>(data.component);
+                auto it = ranges.find({begin, begin + data.componentSize});
+                // another component may have been rendered at the same address since
+                if (it != ranges.end() && it->second == &data) {
+                    ranges.erase(it);
+                }
+                live.erase(&data);
+
+                if (!dependencies.empty()) {
+                    if (auto it = dependencies.find(&data); it != dependencies.end()) {
+                        auto forgotten = std::move(it->second);
+                        dependencies.erase(it);
+                        for (auto dependency : forgotten) {
+                            dependency->forgetReader(data);
+                        }
+                    }
+                }
+            }
+
+            /// @brief Remembers that data read dependency, so it is told once data is forgotten
+            static void addDependency(RenderContextChildData const& data, Dependency* dependency) {
+                dependencies[&data].push_back(dependency);
+            }
+
+            static void removeDependency(RenderContextChildData const& data, Dependency* dependency) noexcept {
+                if (auto it = dependencies.find(&data); it != dependencies.end()) {
+                    std::erase(it->second, dependency);
+                    if (it->second.empty()) dependencies.erase(it);
+                }
+            }
+
+            /// @brief Marks data and every component above it dirty
+            static void markDirty(RenderContextChildData& data) {
+                // walk all the way up, an ancestor rendered on its own may be clean above a dirty one
+                for (auto current = &data; current && live.contains(current); current = current->parent) {
+                    current->dirty = true;
+                }
+            }
+
+            /// @brief Marks the components written to since the last call dirty
+            static void flush() {
+                bool complete = PendingWrites::drain([](void const* address) {
+                    if (auto data = find(reinterpret_cast<uintptr_t>(address))) {
+                        markDirty(*data);
+                    }
+                });
+                if (!complete) version++;
+            }
+
+        private:
+            struct Range {
+                uintptr_t begin;
+                uintptr_t end;
+            };
+
+            // ordered by start, ranges starting at the same address from outermost to innermost
+            struct RangeOrder {
+                constexpr bool operator()(Range const& a, Range const& b) const noexcept {
+                    return a.begin != b.begin ? a.begin < b.begin : a.end > b.end;
+                }
+            };
+
+            static RenderContextChildData* find(uintptr_t address) {
+                // last range starting at or before address, innermost first for equal starts
+                auto it = ranges.upper_bound({address, 0});
+                while (it != ranges.begin()) {
+                    --it;
+                    if (address < it->first.end) return it->second;
+                }
+                return nullptr;
+            }
+
+            // Shared by every context, so not allocated from the resource of any of them. Mounting and unmounting
+            // would otherwise allocate a node for every component, the pool hands freed nodes out again instead.
+            inline static std::pmr::unsynchronized_pool_resource pool;
+            inline static std::pmr::map<Range, RenderContextChildData*, RangeOrder> ranges{&pool};
+            inline static std::pmr::unordered_set<RenderContextChildData const*> live{&pool};
+            inline static std::pmr::unordered_map<RenderContextChildData const*, std::pmr::vector<Dependency*>> dependencies{&pool};
+        };
+
+        inline void forgetComponent(void const* data) noexcept {
+            DirtyTracker::forget(*static_cast<RenderContextChildData const*>(data));
+        }
+
+        template<class T>
+        requires (renderable<T>)
+        // spelled out, the frame below renders T recursively before any return could deduce it
+        static constexpr auto renderSingle(T& child, RenderContext& ctx, RenderContextChildData& childData) -> decltype(child.render(ctx, childData)) {
+            auto parentFrame = DirtyTracker::current;
+            if (!parentFrame) {
+                // writes posted by other threads, applied before they're resolved to dirty components
+                MutationQueue::drain();
+                DirtyTracker::flush();
+            } else if (parentFrame->ctx == &ctx) {
+                parentFrame->data->sharesContext = true;
+            }
+            ctx.markVisited(childData);
+
+            using Result = decltype(child.render(ctx, childData));
+            constexpr bool returnsTransform = std::is_same_v<Result, UnityEngine::Transform*>;
+
+            // Nothing changed in this subtree, the native objects are already up to date
+            if constexpr ((returnsTransform || std::is_void_v<Result>) && !always_render<T>) {
+                if (!childData.dirty && !childData.sharesContext && !childData.rendersAlways && childData.component == &child &&
+                    childData.cleanVersion == DirtyTracker::version) {
+                    if constexpr (returnsTransform) {
+                        return childData.transform;
+                    } else {
+                        return;
+                    }
+                }
+            }
+
+            QUC_PROFILE_RENDER(T, childData);
+            auto mount = !parentFrame ? ctx.mountState : nullptr;
+            if (mount) mount->beginPass();
+            if (MountState::active && !childData.component) MountState::active->created++;
+
+            if (parentFrame) childData.parent = parentFrame->data;
+            DirtyTracker::track(childData, &child, sizeof(T));
+            childData.sharesContext = false;
+            // set again by descendants that always render
+            childData.rendersAlways = always_render<T>;
+
+            DirtyTracker::Frame frame{&childData, &ctx, parentFrame, parentFrame ? parentFrame->depth + 1 : 0, [](void* component, RenderContext& ctx) {
+                auto& root = *static_cast<T*>(component);
+                renderSingle(root, ctx, ctx.getChildData(root.key));
+            }};
+            DirtyTracker::current = &frame;
+            struct FrameGuard {
+                DirtyTracker::Frame* parent;
+                MountState* mount;
+                RenderContextChildData& data;
+                ~FrameGuard() {
+                    DirtyTracker::current = parent;
+                    if (parent && data.rendersAlways) parent->data->rendersAlways = true;
+                    if (mount) mount->endPass();
+                }
+            } guard{parentFrame, mount, childData};
+
+            childData.dirty = false;
+            childData.cleanVersion = DirtyTracker::version;
+
+            if constexpr (std::is_convertible_v<Result, UnityEngine::Transform*>) {
+                auto res = child.render(ctx, childData);
+                childData.transform = res;
+                return res;
+            } else {
+                return child.render(ctx, childData);
+            }
+        }
+
         template<class T>
         requires (renderable<T>)
         static constexpr auto renderSingle(T& child, RenderContext& ctx) {
             auto& childData = ctx.getChildData(child.key);
-            return child.render(ctx, childData);
+            return renderSingle(child, ctx, childData);
+        }
+
+        /// @brief Renders a child of a container, unless an incremental mount has no budget left for creating it.
+        /// Containers ignore what their children return, so leaving one out for now is fine.
+        template<class T>
+        requires (renderable<T>)
+        static constexpr void renderChild(T& child, RenderContext& ctx, RenderContextChildData& childData) {
+            if (auto mount = MountState::active; mount && !childData.component) {
+                auto depth = DirtyTracker::current ? DirtyTracker::current->depth + 1 : 0;
+                if (!mount->mayCreate(depth)) {
+                    ctx.markVisited(childData);
+                    // render the path to this child again on the next pass
+                    for (auto frame = DirtyTracker::current; frame; frame = frame->parent) {
+                        frame->data->dirty = true;
+                    }
+                    return;
+                }
+            }
+            renderSingle(child, ctx, childData);
+        }
+
+        template<class T>
+        requires (renderable<T>)
+        static constexpr void renderChild(T& child, RenderContext& ctx) {
+            renderChild(child, ctx, ctx.getChildData(child.key));
         }
 
         template<size_t idx = 0, class... TArgs>
@@ -178,17 +659,239 @@ namespace QUC {
         static constexpr void renderTuple(std::tuple<TArgs...>& args, RenderContext& ctx) {
             if constexpr (idx < sizeof...(TArgs)) {
                 auto& child = std::get<idx>(args);
-                renderSingle(child, ctx); // render child
+                renderChild(child, ctx); // render child
                 renderTuple<idx + 1>(args, ctx);
             }
         }
 
+        template<size_t idx = 0, class... TArgs>
+        requires ((renderable<TArgs> && ...))
+        static constexpr void resolveSlots(std::tuple<TArgs...>& args, RenderContext& ctx, ChildSlots<sizeof...(TArgs)>& slots) {
+            if constexpr (idx < sizeof...(TArgs)) {
+                slots.slots[idx] = &ctx.getChildData(std::get<idx>(args).key);
+                resolveSlots<idx + 1>(args, ctx, slots);
+            }
+        }
+
+        template<size_t idx = 0, class... TArgs>
+        requires ((renderable<TArgs> && ...))
+        static constexpr void renderSlots(std::tuple<TArgs...>& args, RenderContext& ctx, ChildSlots<sizeof...(TArgs)>& slots) {
+            if constexpr (idx < sizeof...(TArgs)) {
+                renderChild(std::get<idx>(args), ctx, *slots.slots[idx]); // render child
+                renderSlots<idx + 1>(args, ctx, slots);
+            }
+        }
+
+        /// @brief Renders a fixed amount of children, looking up their data by position instead of key.
+        /// The keyed lookup only happens on the first render or after child data was removed from ctx.
+        template<class... TArgs>
+        requires ((renderable<TArgs> && ...))
+        static constexpr void renderTuple(std::tuple<TArgs...>& args, RenderContext& ctx, RenderContextChildData& data) {
+            auto& slots = data.getChildSlots<sizeof...(TArgs)>();
+            if (!slots.isValidFor(ctx)) {
+                ctx.reserveChildren(sizeof...(TArgs));
+                resolveSlots(args, ctx, slots);
+                slots.ctx = &ctx;
+                slots.generation = ctx.getGeneration();
+            }
+            renderSlots(args, ctx, slots);
+        }
+
         template<typename T>
         requires (renderable<T>)
         static constexpr void renderDynamicList(std::span<T> const args, RenderContext& ctx) {
             for (auto& child : args) {
-                renderSingle<T>(child, ctx); // render child
+                renderChild<T>(child, ctx); // render child
+            }
+        }
+
+        /// @brief Reconciliation state of a list rendered with renderKeyedList, kept in the list component's data.
+        /// Allocates from the memory resource of the list's context when created through getData.
+        struct KeyedList {
+            using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+            /// @brief Marks a child that wasn't in the list on the previous render
+            static constexpr uint32_t created = UINT32_MAX;
+            /// @brief Marks a key that was already seen earlier in the list
+            static constexpr uint32_t seen = UINT32_MAX - 1;
+
+            KeyedList() : KeyedList(allocator_type()) {}
+            explicit KeyedList(allocator_type allocator) :
+                keys(allocator), transforms(allocator), index(allocator.resource()), nextKeys(allocator),
+                nextTransforms(allocator), sources(allocator), kept(allocator), stable(allocator), tails(allocator),
+                predecessors(allocator) {}
+
+            /// @brief Keys and returned transforms in list order, as of the last render
+            std::pmr::vector<Key> keys;
+            std::pmr::vector<UnityEngine::Transform*> transforms;
+
+            // Scratch space, kept around so rendering an unchanged list doesn't allocate
+            KeyMap<uint32_t> index;
+            std::pmr::vector<Key> nextKeys;
+            std::pmr::vector<UnityEngine::Transform*> nextTransforms;
+            /// @brief Index of each child in the previous render, or created/seen
+            std::pmr::vector<uint32_t> sources;
+            std::pmr::vector<bool> kept;
+            std::pmr::vector<bool> stable;
+            std::pmr::vector<uint32_t> tails;
+            std::pmr::vector<uint32_t> predecessors;
+        };
+
+        /// @brief Marks a longest strictly increasing subsequence of sources in stable, ignoring values >= KeyedList::seen.
+        /// O(n log n)
+        inline void markLongestIncreasing(std::span<uint32_t const> sources, std::pmr::vector<uint32_t>& tails, std::pmr::vector<uint32_t>& predecessors, std::pmr::vector<bool>& stable) {
+            constexpr uint32_t none = UINT32_MAX;
+            tails.clear();
+            predecessors.assign(sources.size(), none);
+            stable.assign(sources.size(), false);
+
+            // tails[k] is the position ending the smallest-valued increasing run of length k + 1
+            for (uint32_t i = 0; i < sources.size(); i++) {
+                if (sources[i] >= KeyedList::seen) continue;
+
+                auto it = std::lower_bound(tails.begin(), tails.end(), sources[i], [&](uint32_t pos, uint32_t value) {
+                    return sources[pos] < value;
+                });
+                if (it != tails.begin()) predecessors[i] = *(it - 1);
+                if (it == tails.end()) {
+                    tails.push_back(i);
+                } else {
+                    *it = i;
+                }
+            }
+
+            for (auto i = tails.empty() ? none : tails.back(); i != none; i = predecessors[i]) {
+                stable[i] = true;
+            }
+        }
+
+        /// @brief The ancestor of transform (or transform itself) that is a direct child of parent, nullptr if there is none
+        inline UnityEngine::Transform* siblingUnder(UnityEngine::Transform* transform, UnityEngine::Transform const& parent) {
+            while (transform) {
+                auto transformParent = QUC_NATIVE_CALL(transform->get_parent());
+                if (transformParent == &parent) return transform;
+                transform = transformParent;
+            }
+            return nullptr;
+        }
+
+        /// @brief Moves the children of a keyed list into list order, see renderKeyedList
+        inline void moveIntoOrder(UnityEngine::Transform& parent, KeyedList& list) {
+            auto& sources = list.sources;
+            for (size_t i = 0; i < sources.size(); i++) {
+                auto transform = list.nextTransforms[i];
+                // can't be moved, so it can't anchor the others either
+                if (!transform || !transform->m_CachedPtr) sources[i] = KeyedList::seen;
+            }
+            markLongestIncreasing(sources, list.tails, list.predecessors, list.stable);
+
+            // The previous last child is at the end of the list's siblings. Nothing was moved yet, so it still is.
+            auto end = [&]() -> UnityEngine::Transform* {
+                for (auto it = list.transforms.rbegin(); it != list.transforms.rend(); it++) {
+                    if (*it && (*it)->m_CachedPtr) return siblingUnder(*it, parent);
+                }
+                return nullptr;
+            };
+
+            // Back to front, so the next child is always in its final place already
+            UnityEngine::Transform* next = nullptr;
+            for (size_t i = sources.size(); i-- > 0;) {
+                auto transform = list.nextTransforms[i];
+                if (sources[i] == KeyedList::seen) continue;
+                if (list.stable[i]) {
+                    next = transform;
+                    continue;
+                }
+
+                auto sibling = siblingUnder(transform, parent);
+                if (!sibling) continue;
+
+                if (next) {
+                    auto nextSibling = siblingUnder(next, parent);
+                    if (nextSibling) {
+                        int index = QUC_NATIVE_CALL(sibling->GetSiblingIndex());
+                        int nextIndex = QUC_NATIVE_CALL(nextSibling->GetSiblingIndex());
+                        QUC_NATIVE_CALL(sibling->SetSiblingIndex(index < nextIndex ? nextIndex - 1 : nextIndex));
+                    }
+                } else if (auto last = end(); last && last != sibling) {
+                    int index = QUC_NATIVE_CALL(sibling->GetSiblingIndex());
+                    int lastIndex = QUC_NATIVE_CALL(last->GetSiblingIndex());
+                    QUC_NATIVE_CALL(sibling->SetSiblingIndex(index <= lastIndex ? lastIndex : lastIndex + 1));
+                }
+                next = sibling;
+            }
+        }
+
+        /// @brief Renders a list whose children may be added, removed or reordered between renders, matching them up by key.
+        /// Children whose key is gone are destroyed. If the children return their transform, they are moved into list order
+        /// with as few moves as possible: the longest run of children that kept their relative order stays where it is.
+        /// Keys appearing more than once share their data and are rendered but not moved.
+        template<typename T>
+        requires (renderable<T>)
+        static void renderKeyedList(std::span<T> const args, RenderContext& ctx, KeyedList& list) {
+            constexpr bool returnsTransform = std::is_same_v<decltype(std::declval<T&>().render(std::declval<RenderContext&>(), std::declval<RenderContextChildData&>())), UnityEngine::Transform*>;
+
+            // Same keys in the same order, the usual re-render: nothing is moved or destroyed, and nothing allocates
+            bool unchanged = args.size() == list.keys.size() && std::equal(args.begin(), args.end(), list.keys.begin(), [](T const& child, Key const& key) {
+                return child.key == key;
+            });
+            if (unchanged) {
+                for (uint32_t i = 0; i < args.size(); i++) {
+                    auto& childData = ctx.getChildData(args[i].key);
+                    renderChild(args[i], ctx, childData); // render child
+                    if constexpr (returnsTransform) {
+                        list.transforms[i] = childData.transform;
+                    }
+                }
+                return;
+            }
+
+            if (list.keys.empty()) ctx.reserveChildren(args.size());
+            list.index.clear();
+            for (uint32_t i = 0; i < list.keys.size(); i++) {
+                list.index.tryEmplace(list.keys[i], i);
             }
+            list.kept.assign(list.keys.size(), false);
+            list.sources.resize(args.size());
+            list.nextKeys.clear();
+            list.nextTransforms.assign(args.size(), nullptr);
+
+            for (uint32_t i = 0; i < args.size(); i++) {
+                auto& child = args[i];
+
+                auto [source, inserted] = list.index.tryEmplace(child.key, KeyedList::seen);
+                if (inserted) {
+                    list.sources[i] = KeyedList::created;
+                } else if (*source == KeyedList::seen) {
+                    list.sources[i] = KeyedList::seen;
+                } else {
+                    list.sources[i] = *source;
+                    list.kept[*source] = true;
+                    *source = KeyedList::seen;
+                }
+
+                auto& childData = ctx.getChildData(child.key);
+                renderChild(child, ctx, childData); // render child
+                if constexpr (returnsTransform) {
+                    list.nextTransforms[i] = childData.transform;
+                }
+                list.nextKeys.push_back(child.key);
+            }
+
+            // Children created on the first render are already appended in order
+            if constexpr (returnsTransform) {
+                if (!list.keys.empty()) {
+                    moveIntoOrder(ctx.parentTransform, list);
+                }
+            }
+
+            // Destroyed after moving, the previous last child may be needed as anchor
+            for (uint32_t i = 0; i < list.keys.size(); i++) {
+                if (!list.kept[i]) ctx.destroyChild(list.keys[i]);
+            }
+
+            list.keys.swap(list.nextKeys);
+            list.transforms.swap(list.nextTransforms);
         }
 
         template<size_t idx = 0, class... TArgs>
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace QUC {
+    namespace detail {
+        /// @brief Addresses of HeldData written since the last render.
+        /// The render context resolves them to the components holding them and marks those dirty,
+        /// so rendering the tree again only visits components that changed.
+        /// Writes may come from any thread. Each thread buffers its writes in a fixed size ring that only the
+        /// render thread takes from, so writing never locks and the buffered writes never grow past capacity.
+        struct PendingWrites {
+            /// @brief Writes of different fields a thread buffers until the next render. Once a ring is full
+            /// further writes are dropped, and drain() reports that the next render has to visit everything.
+            static constexpr size_t capacity = 4096;
+
+            static void push(void const* address) {
+                auto& writer = local;
+                // the same value is often written several times before it's rendered
+                if (writer.seen(address)) return;
+
+                if (holding > 0) {
+                    if (held.size() == capacity) compactHeld();
+                    held.push_back(address);
+                    return;
+                }
+                writer.push(address);
+            }
+
+            /// @brief Calls f(void const*) for each written address. Only call this from the render thread.
+            /// @return false if writes were dropped since the last drain, see capacity
+            template<typename F>
+            static bool drain(F&& f) {
+                // writes after this are pushed again, even if they were pushed before
+                drains.fetch_add(1, std::memory_order_acq_rel);
+
+                // rendering inside a batch still has to see its writes
+                if (!held.empty()) {
+                    for (auto address : held) {
+                        f(address);
+                    }
+                    held.clear();
+                }
+
+                {
+                    std::lock_guard lock(mutex);
+                    for (auto const& ring : rings) {
+                        ring->drain(f);
+                    }
+                    // rings of threads that ended, once they're empty
+                    std::erase_if(rings, [](std::shared_ptr<Ring> const& ring) {
+                        return ring.use_count() == 1 && ring->empty();
+                    });
+                }
+                return !dropped.exchange(false, std::memory_order_acq_rel);
+            }
+
+            /// @brief Keeps the writes of this thread to itself until the matching release(), see Batch
+            static void hold() noexcept {
+                holding++;
+            }
+
+            /// @brief Publishes the writes held back since the outermost hold(), each address once
+            static void release() {
+                if (--holding > 0 || held.empty()) return;
+
+                std::sort(held.begin(), held.end());
+                held.erase(std::unique(held.begin(), held.end()), held.end());
+                for (auto address : held) {
+                    local.push(address);
+                }
+                held.clear();
+            }
+
+        private:
+            /// @brief Single producer, single consumer ring of written addresses
+            struct Ring {
+                std::unique_ptr<void const*[]> slots = std::make_unique<void const*[]>(capacity);
+                /// @brief Only written by the thread owning the ring
+                std::atomic<size_t> head = 0;
+                /// @brief Only written by the render thread
+                std::atomic<size_t> tail = 0;
+
+                bool push(void const* address) noexcept {
+                    auto next = head.load(std::memory_order_relaxed);
+                    if (next - tail.load(std::memory_order_acquire) == capacity) return false;
+                    slots[next % capacity] = address;
+                    head.store(next + 1, std::memory_order_release);
+                    return true;
+                }
+
+                template<typename F>
+                void drain(F& f) {
+                    auto first = tail.load(std::memory_order_relaxed);
+                    auto last = head.load(std::memory_order_acquire);
+                    for (auto i = first; i != last; i++) {
+                        f(slots[i % capacity]);
+                    }
+                    tail.store(last, std::memory_order_release);
+                }
+
+                [[nodiscard]] bool empty() const noexcept {
+                    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_relaxed);
+                }
+            };
+
+            /// @brief The ring of a thread, and the addresses it pushed since the last drain
+            struct Writer {
+                static constexpr int recentBits = 6;
+
+                std::shared_ptr<Ring> ring;
+                // direct mapped, a miss only costs pushing an address twice
+                std::array<void const*, 1 << recentBits> recent;
+                uint64_t drained;
+
+                // not default member initializers, GCC can't use those before PendingWrites is complete
+                Writer() noexcept : recent(), drained(0) {}
+
+                bool seen(void const* address) noexcept {
+                    auto current = drains.load(std::memory_order_acquire);
+                    if (drained != current) {
+                        recent.fill(nullptr);
+                        drained = current;
+                    }
+
+                    auto hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(address)) * 0x9E3779B97F4A7C15ull;
+                    auto& slot = recent[hash >> (64 - recentBits)];
+                    if (slot == address) return true;
+                    slot = address;
+                    return false;
+                }
+
+                void push(void const* address) {
+                    if (!ring) {
+                        ring = std::make_shared<Ring>();
+                        std::lock_guard lock(mutex);
+                        rings.push_back(ring);
+                    }
+                    if (!ring->push(address)) {
+                        dropped.store(true, std::memory_order_release);
+                    }
+                }
+            };
+
+            /// @brief Removes repeated addresses from held, or gives up on them once that isn't enough
+            static void compactHeld() {
+                std::sort(held.begin(), held.end());
+                held.erase(std::unique(held.begin(), held.end()), held.end());
+                if (held.size() > capacity / 2) {
+                    held.clear();
+                    dropped.store(true, std::memory_order_release);
+                }
+            }
+
+            inline static thread_local uint32_t holding = 0;
+            inline static thread_local std::vector<void const*> held;
+            inline static thread_local Writer local;
+            /// @brief How often drain() was called, clears the recently pushed addresses of every writer
+            inline static std::atomic<uint64_t> drains = 0;
+            inline static std::atomic<bool> dropped = false;
+            /// @brief Guards rings, which is only changed when a thread writes for the first time or in drain()
+            inline static std::mutex mutex;
+            inline static std::vector<std::shared_ptr<Ring>> rings;
+        };
+
+        constexpr void markWritten(void const* address) {
+            if (!std::is_constant_evaluated()) {
+                PendingWrites::push(address);
+            }
+        }
+    }
+}
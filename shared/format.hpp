@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace QUC {
+    /// @brief A string literal usable as a template argument, e.g. the template of a FormattedText
+    template<size_t N>
+    struct FixedString {
+        char chars[N]{};
+
+        consteval FixedString(char const (&str)[N]) {
+            std::copy_n(str, N, chars);
+        }
+
+        [[nodiscard]] constexpr std::string_view view() const noexcept {
+            return {chars, N - 1};
+        }
+    };
+
+    namespace detail {
+        /// @brief A format string taken apart at compile time: the literal text with escapes resolved,
+        /// and where each field goes in it. Fields are `{}`, or `{:.N}` for N decimals of a floating point value.
+        /// `{{` and `}}` are literal braces.
+        template<size_t N>
+        struct CompiledFormat {
+            char literals[N]{};
+            size_t literalLength = 0;
+            /// @brief Where field i goes in literals, and past the last field the end of the literals
+            size_t fieldOffsets[N + 1]{};
+            /// @brief Decimals of field i, -1 if not given
+            int precisions[N]{};
+            size_t fields = 0;
+            bool valid = true;
+        };
+
+        template<FixedString format>
+        consteval auto compileFormat() {
+            constexpr auto text = format.view();
+            CompiledFormat<text.size() + 1> result;
+
+            for (size_t i = 0; i < text.size(); i++) {
+                char c = text[i];
+                bool escaped = (c == '{' || c == '}') && i + 1 < text.size() && text[i + 1] == c;
+                if (escaped) {
+                    result.literals[result.literalLength++] = c;
+                    i++;
+                } else if (c == '{') {
+                    // not find(), GCC can't evaluate it on a template argument at compile time
+                    auto end = i;
+                    while (end < text.size() && text[end] != '}') end++;
+                    if (end == text.size()) {
+                        result.valid = false;
+                        break;
+                    }
+
+                    int precision = -1;
+                    auto spec = text.substr(i + 1, end - i - 1);
+                    if (!spec.empty()) {
+                        if (spec.size() < 3 || !spec.starts_with(":.")) {
+                            result.valid = false;
+                            break;
+                        }
+                        precision = 0;
+                        for (char digit : spec.substr(2)) {
+                            if (digit < '0' || digit > '9') result.valid = false;
+                            precision = precision * 10 + (digit - '0');
+                        }
+                    }
+
+                    result.fieldOffsets[result.fields] = result.literalLength;
+                    result.precisions[result.fields] = precision;
+                    result.fields++;
+                    i = end;
+                } else if (c == '}') {
+                    result.valid = false;
+                    break;
+                } else {
+                    result.literals[result.literalLength++] = c;
+                }
+            }
+            result.fieldOffsets[result.fields] = result.literalLength;
+            return result;
+        }
+
+        template<class T>
+        inline constexpr bool formattable = std::is_arithmetic_v<T> || std::is_convertible_v<T const&, std::string_view>;
+
+        template<class T>
+        void appendField(std::string& out, T const& value, int precision) {
+            if constexpr (std::is_same_v<T, bool>) {
+                out.append(value ? "true" : "false");
+            } else if constexpr (std::is_same_v<T, char>) {
+                out.push_back(value);
+            } else if constexpr (std::is_integral_v<T>) {
+                char buffer[24];
+                auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+                out.append(buffer, result.ptr);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                // to_chars for floating point isn't in every libc++ we build with
+                char buffer[64];
+                int length = precision >= 0 ? std::snprintf(buffer, sizeof(buffer), "%.*f", precision, static_cast<double>(value))
+                                            : std::snprintf(buffer, sizeof(buffer), "%g", static_cast<double>(value));
+                out.append(buffer, std::clamp<int>(length, 0, sizeof(buffer) - 1));
+            } else {
+                out.append(std::string_view(value));
+            }
+        }
+
+        /// @brief Appends format with the values in its fields to out, which only allocates if out has to grow
+        template<FixedString format, class... Args>
+        void formatTo(std::string& out, std::tuple<Args...> const& values) {
+            static constexpr auto compiled = compileFormat<format>();
+            static_assert(compiled.valid, "Format fields are {} or {:.N}, write {{ and }} for literal braces");
+            static_assert(compiled.fields == sizeof...(Args), "The format needs one field for each value");
+            static_assert((formattable<Args> && ...), "Only numbers, bools and strings can be formatted");
+
+            std::string_view literals(compiled.literals, compiled.literalLength);
+            size_t literal = 0;
+            [&]<size_t... fields>(std::index_sequence<fields...>) {
+                ((out.append(literals.substr(literal, compiled.fieldOffsets[fields] - literal)),
+                  appendField(out, std::get<fields>(values), compiled.precisions[fields]),
+                  literal = compiled.fieldOffsets[fields]), ...);
+            }(std::index_sequence_for<Args...>());
+            out.append(literals.substr(literal));
+        }
+
+        /// @brief Reused for every formatted text, so formatting stops allocating once they are big enough.
+        /// Must only be used on the main thread.
+        struct FormatBuffers {
+            inline static std::string utf8;
+            inline static std::u16string utf16;
+        };
+
+        /// @brief Appends UTF-8 text to out as UTF-16, invalid sequences become U+FFFD
+        inline void appendUtf16(std::u16string& out, std::string_view utf8) {
+            for (size_t i = 0; i < utf8.size();) {
+                auto lead = static_cast<unsigned char>(utf8[i]);
+                size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+                if (length == 1) {
+                    out.push_back(lead);
+                    i++;
+                    continue;
+                }
+
+                char32_t codepoint = length == 0 || i + length > utf8.size() ? 0xFFFD : lead & (0x7F >> length);
+                for (size_t j = 1; j < length && codepoint != 0xFFFD; j++) {
+                    auto continuation = static_cast<unsigned char>(utf8[i + j]);
+                    codepoint = (continuation & 0xC0) == 0x80 ? (codepoint << 6) | (continuation & 0x3F) : 0xFFFD;
+                }
+                i += codepoint == 0xFFFD ? 1 : length;
+
+                if (codepoint >= 0x10000) {
+                    codepoint -= 0x10000;
+                    out.push_back(static_cast<char16_t>(0xD800 + (codepoint >> 10)));
+                    out.push_back(static_cast<char16_t>(0xDC00 + (codepoint & 0x3FF)));
+                } else {
+                    out.push_back(static_cast<char16_t>(codepoint));
+                }
+            }
+        }
+    }
+}
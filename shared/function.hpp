@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace QUC {
+    namespace detail {
+        template<typename T>
+        inline constexpr bool isStdFunction = false;
+
+        template<typename Signature>
+        inline constexpr bool isStdFunction<std::function<Signature>> = true;
+
+        /// @brief Callables that can be empty, and make an empty function then
+        template<typename F>
+        inline constexpr bool nullableCallable = std::is_pointer_v<F> || std::is_member_pointer_v<F> || isStdFunction<F>;
+
+        template<typename Signature, size_t Capacity, bool copyable>
+        struct InlineFunction;
+
+        /// @brief Storage of InlineFunction and UniqueFunction, see those
+        template<typename R, typename... Args, size_t Capacity, bool copyable>
+        struct InlineFunction<R(Args...), Capacity, copyable> {
+            using result_type = R;
+
+            /// @brief Whether a callable of type F is kept in place instead of on the heap
+            template<typename F>
+            static constexpr bool storedInline = sizeof(F) <= Capacity &&
+                                                 alignof(F) <= alignof(void*) &&
+                                                 std::is_nothrow_move_constructible_v<F>;
+
+            InlineFunction() noexcept = default;
+            InlineFunction(std::nullptr_t) noexcept {}
+
+            template<typename F, typename Fn = std::decay_t<F>>
+            requires (!std::is_same_v<Fn, InlineFunction> && std::is_invocable_r_v<R, Fn&, Args...> &&
+                      (!copyable || std::is_copy_constructible_v<Fn>))
+            InlineFunction(F&& f) {
+                if constexpr (nullableCallable<Fn>) {
+                    if (f == nullptr) return;
+                }
+
+                if constexpr (storedInline<Fn>) {
+                    new (storage) Fn(std::forward<F>(f));
+                } else {
+                    *reinterpret_cast<Fn**>(storage) = new Fn(std::forward<F>(f));
+                }
+                ops = &opsFor<Fn>;
+            }
+
+            InlineFunction(InlineFunction const& other) requires (copyable) {
+                if (other.ops) {
+                    other.ops->copy(storage, other.storage);
+                    ops = other.ops;
+                }
+            }
+
+            InlineFunction(InlineFunction&& other) noexcept {
+                moveFrom(other);
+            }
+
+            InlineFunction& operator=(InlineFunction const& other) requires (copyable) {
+                if (this != &other) {
+                    InlineFunction copy(other);
+                    reset();
+                    moveFrom(copy);
+                }
+                return *this;
+            }
+
+            InlineFunction& operator=(InlineFunction&& other) noexcept {
+                if (this != &other) {
+                    reset();
+                    moveFrom(other);
+                }
+                return *this;
+            }
+
+            InlineFunction& operator=(std::nullptr_t) noexcept {
+                reset();
+                return *this;
+            }
+
+            template<typename F>
+            requires (std::is_constructible_v<InlineFunction, F&&> && !std::is_same_v<std::decay_t<F>, InlineFunction>)
+            InlineFunction& operator=(F&& f) {
+                InlineFunction next(std::forward<F>(f));
+                reset();
+                moveFrom(next);
+                return *this;
+            }
+
+            ~InlineFunction() {
+                reset();
+            }
+
+            /// @brief Calls the callable, which may change its captures like with std::function
+            R operator()(Args... args) const {
+                if (!ops) throw std::bad_function_call();
+                return ops->invoke(const_cast<std::byte*>(storage), std::forward<Args>(args)...);
+            }
+
+            explicit operator bool() const noexcept {
+                return ops != nullptr;
+            }
+
+            friend bool operator==(InlineFunction const& function, std::nullptr_t) noexcept {
+                return !function.ops;
+            }
+
+        private:
+            struct Ops {
+                R (*invoke)(void* storage, Args&&... args);
+                void (*move)(void* to, void* from) noexcept;
+                void (*copy)(void* to, void const* from);
+                void (*destroy)(void* storage) noexcept;
+            };
+
+            template<typename Fn>
+            static Fn* target(void* storage) noexcept {
+                if constexpr (storedInline<Fn>) {
+                    return std::launder(reinterpret_cast<Fn*>(storage));
+                } else {
+                    return *reinterpret_cast<Fn**>(storage);
+                }
+            }
+
+            template<typename Fn>
+            static constexpr Ops opsFor = {
+                [](void* storage, Args&&... args) -> R {
+                    if constexpr (std::is_void_v<R>) {
+                        std::invoke(*target<Fn>(storage), std::forward<Args>(args)...);
+                    } else {
+                        return std::invoke(*target<Fn>(storage), std::forward<Args>(args)...);
+                    }
+                },
+                [](void* to, void* from) noexcept {
+                    if constexpr (storedInline<Fn>) {
+                        new (to) Fn(std::move(*target<Fn>(from)));
+                        target<Fn>(from)->~Fn();
+                    } else {
+                        // the heap allocation changes hands
+                        *reinterpret_cast<Fn**>(to) = target<Fn>(from);
+                    }
+                },
+                [](void* to, void const* from) {
+                    if constexpr (copyable) {
+                        auto source = target<Fn>(const_cast<void*>(from));
+                        if constexpr (storedInline<Fn>) {
+                            new (to) Fn(*source);
+                        } else {
+                            *reinterpret_cast<Fn**>(to) = new Fn(*source);
+                        }
+                    }
+                },
+                [](void* storage) noexcept {
+                    if constexpr (storedInline<Fn>) {
+                        target<Fn>(storage)->~Fn();
+                    } else {
+                        delete target<Fn>(storage);
+                    }
+                }
+            };
+
+            void moveFrom(InlineFunction& other) noexcept {
+                if (other.ops) {
+                    other.ops->move(storage, other.storage);
+                    ops = std::exchange(other.ops, nullptr);
+                }
+            }
+
+            void reset() noexcept {
+                if (ops) {
+                    std::exchange(ops, nullptr)->destroy(storage);
+                }
+            }
+
+            // at least one pointer, so a callable on the heap fits
+            alignas(void*) std::byte storage[Capacity < sizeof(void*) ? sizeof(void*) : Capacity];
+            Ops const* ops = nullptr;
+        };
+    }
+
+    /// @brief Callables that fit in this many bytes are stored without allocating, see InlineFunction
+    inline constexpr size_t inlineFunctionCapacity = 4 * sizeof(void*);
+
+    /// @brief A std::function that keeps callables of up to Capacity bytes in place, so creating or copying
+    /// one never allocates (e.g. when a component holding a callback is copied). Bigger callables, or those
+    /// that can't be moved without throwing, are allocated on the heap like std::function would.
+    /// Copying copies the callable, like std::function.
+    template<typename Signature, size_t Capacity = inlineFunctionCapacity>
+    using InlineFunction = detail::InlineFunction<Signature, Capacity, true>;
+
+    /// @brief A move-only InlineFunction, for callbacks with one owner. Also takes callables that can't be copied.
+    template<typename Signature, size_t Capacity = inlineFunctionCapacity>
+    using UniqueFunction = detail::InlineFunction<Signature, Capacity, false>;
+}
@@ -1,11 +1,58 @@
 #pragma once
 
 #include <utility>
-#include <chrono>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 
 namespace QUC {
+    namespace detail {
+        /// @brief Hands out process-unique key ids.
+        /// Each thread reserves a block of ids from a shared atomic counter and then
+        /// allocates from that block without any synchronization, so building components
+        /// is a thread local increment in the common case.
+        struct KeyAllocator {
+            static constexpr uint64_t blockSize = 1024;
+
+            static uint64_t next() noexcept {
+                thread_local uint64_t current = 0;
+                thread_local uint64_t end = 0;
+
+                if (current == end) [[unlikely]] {
+                    current = counter.fetch_add(blockSize, std::memory_order_relaxed);
+                    end = current + blockSize;
+                }
+
+                return current++;
+            }
+
+        private:
+            // 0 is never handed out
+            inline static std::atomic<uint64_t> counter = blockSize;
+        };
+
+        /// @brief splitmix64 finalizer, sequential ids end up spread over the whole hash range
+        constexpr uint64_t mixKey(uint64_t x) noexcept {
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebULL;
+            x ^= x >> 31;
+            return x;
+        }
+
+        /// @brief Hash of two addresses together, such as a component and the context it renders into
+        inline size_t hashPointers(void const* first, void const* second) noexcept {
+            auto a = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(first));
+            auto b = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(second));
+            // mixed twice, so swapping the two doesn't collide
+            return static_cast<size_t>(mixKey(mixKey(a) ^ b));
+        }
+    }
+
     struct Key {
-        Key() : seed(std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::high_resolution_clock::now().time_since_epoch()).count())
+        Key() : seed(detail::KeyAllocator::next())
         {}
 
         bool operator==(const Key &rhs) const = default;
@@ -24,8 +71,7 @@ namespace std {
     template<>
     struct hash<QUC::Key> {
         std::size_t operator()(const QUC::Key& obj) const noexcept {
-            std::hash<uint64_t> hash;
-            return hash(obj.seed);
+            return static_cast<std::size_t>(QUC::detail::mixKey(obj.seed));
         }
     };
 
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "context.hpp"
+#include "backend.hpp"
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace QUC {
+    /// @brief Limits of how much of a tree mountIncrementally creates each frame
+    struct MountOptions {
+        /// @brief Components created per frame at most
+        size_t maxCreatesPerFrame = 32;
+        /// @brief Time spent rendering per frame, checked before creating each component
+        std::chrono::steady_clock::duration maxTimePerFrame = std::chrono::milliseconds(3);
+    };
+
+    namespace detail {
+        template<class T>
+        struct IncrementalMount : std::enable_shared_from_this<IncrementalMount<T>> {
+            T& root;
+            RenderContext& ctx;
+            MountState state;
+            std::promise<void> promise;
+            std::function<void()> onComplete;
+
+            IncrementalMount(T& root, RenderContext& ctx, MountOptions const& options, std::function<void()> onComplete)
+                : root(root), ctx(ctx), state{options.maxCreatesPerFrame, options.maxTimePerFrame}, onComplete(std::move(onComplete)) {}
+
+            void step() {
+                if (state.cancelled) return;
+
+                state.startFrame();
+                while (true) {
+                    detail::renderSingle(root, ctx);
+                    // the tree was destroyed while rendering
+                    if (state.cancelled) return;
+
+                    if (state.isComplete()) {
+                        ctx.mountState = nullptr;
+                        promise.set_value();
+                        if (onComplete) onComplete();
+                        return;
+                    }
+
+                    if (state.blocked) break;
+                    // everything up to the frontier exists, go one level deeper in the same frame
+                    state.frontier++;
+                }
+
+                Backend::scheduleOnMainThread([self = this->shared_from_this()] {
+                    self->step();
+                });
+            }
+        };
+    }
+
+    /// @brief Mounts root on ctx over several frames instead of creating the whole tree at once.
+    /// The tree is created breadth first, so the outer layout shows up first and its contents fill in
+    /// over the following frames. Each frame creates at most options.maxCreatesPerFrame components,
+    /// and stops early once options.maxTimePerFrame is used up.
+    /// Rendering root yourself while it mounts is fine, the render continues from what already exists.
+    /// Destroying ctx cancels the mount, which breaks the returned future.
+    /// Must be called on the main thread, root and ctx must outlive the mount.
+    /// @param onComplete Called on the main thread once the whole tree is mounted
+    /// @return Becomes ready once the whole tree is mounted
+    template<class T>
+    requires (renderable<T>)
+    std::future<void> mountIncrementally(T& root, RenderContext& ctx, MountOptions const& options = {}, std::function<void()> onComplete = {}) {
+        auto mount = std::make_shared<detail::IncrementalMount<T>>(root, ctx, options, std::move(onComplete));
+        auto future = mount->promise.get_future();
+
+        // a previous mount on this context is superseded
+        if (ctx.mountState) ctx.mountState->cancelled = true;
+        ctx.mountState = &mount->state;
+
+        mount->step();
+        return future;
+    }
+}
@@ -0,0 +1,352 @@
+#pragma once
+
+#include "key.hpp"
+#include "state.hpp"
+
+#include <array>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace QUC {
+    /// @brief Hands state changes from other threads to the render thread.
+    /// Writing to a HeldData from a worker while the main thread renders is a data race, so workers
+    /// post the write instead. Posted writes and closures are applied in order at the start of the
+    /// next render pass, or whenever drain() is called.
+    /// Each field has one pending slot. A write replaces the value waiting in it, and only a write to
+    /// an empty slot queues the field, so pending work grows with the amount of written fields instead
+    /// of the amount of writes, and posting doesn't allocate once a field was written before.
+    /// A closure sees every write posted before it, or a newer value of the same field.
+    /// Posting never blocks the render thread. Fields and anything captured by closures must stay alive
+    /// until the mutation is applied, or clear() was called.
+    struct MutationQueue {
+        /// @brief Fields that can have a pending value at the same time. Writes to further fields
+        /// are still applied, but each of them is queued (and allocated) on its own.
+        static constexpr size_t slotCount = 1024;
+        /// @brief Drains after which the slot of a field that wasn't written again is given up
+        static constexpr uint64_t idleDrains = 64;
+
+        /// @brief Sets field to value on the render thread. Safe to call from any thread.
+        template<class T, class U>
+        requires (std::is_constructible_v<T, U&&>)
+        static void post(HeldData<T>& field, U&& value) {
+            postWrite<T>(field, std::forward<U>(value));
+        }
+
+        /// @brief Sets a tracked field to value on the render thread. Safe to call from any thread.
+        template<class T, class Owner, size_t bit, class U>
+        requires (std::is_constructible_v<T, U&&>)
+        static void post(TrackedData<T, Owner, bit>& field, U&& value) {
+            postWrite<T>(field, std::forward<U>(value));
+        }
+
+        /// @brief Calls f() on the render thread. Safe to call from any thread.
+        template<class F>
+        requires (std::is_invocable_v<std::decay_t<F>&>)
+        static void post(F&& f) {
+            push(new Mutation<std::decay_t<F>>(std::forward<F>(f)));
+        }
+
+        /// @brief Applies every pending mutation. Only call this from the render thread.
+        /// @return The amount of applied mutations
+        static size_t drain() {
+            drains++;
+            size_t applied = 0;
+            for (auto node = takeInOrder(); node;) {
+                // a slot may be queued again as soon as it's applied
+                auto next = node->next;
+                applied += node->apply();
+                node = next;
+            }
+            releaseIdleSlots();
+            return applied;
+        }
+
+        /// @brief Drops every pending mutation without applying it. Only call this from the render thread.
+        static void clear() {
+            for (auto node = takeInOrder(); node;) {
+                auto next = node->next;
+                node->drop();
+                node = next;
+            }
+        }
+
+        [[nodiscard]] static bool empty() noexcept {
+            return head.load(std::memory_order_relaxed) == nullptr;
+        }
+
+    private:
+        struct MutationBase {
+            MutationBase* next;
+
+            // not default member initializers, GCC can't use those before MutationQueue is complete
+            MutationBase() noexcept : next(nullptr) {}
+            virtual ~MutationBase() = default;
+            /// @return Whether anything was applied
+            virtual bool apply() = 0;
+            virtual void drop() = 0;
+        };
+
+        /// @brief A posted closure, deleted once it ran
+        template<class F>
+        struct Mutation final : MutationBase {
+            F f;
+
+            template<class Q>
+            explicit Mutation(Q&& f) : f(std::forward<Q>(f)) {}
+
+            bool apply() override {
+                f();
+                delete this;
+                return true;
+            }
+
+            void drop() override {
+                delete this;
+            }
+        };
+
+        struct ValueBase {};
+
+        template<class T>
+        struct Value : ValueBase {
+            std::optional<T> value;
+        };
+
+        /// @brief What a slot needs to know about the type of its field. Also tells fields at the same address apart.
+        struct FieldOps {
+            void (*assign)(void const* field, ValueBase* value);
+            void (*destroy)(ValueBase* value);
+        };
+
+        template<class Field, class T>
+        inline static constexpr FieldOps opsOf = {
+            [](void const* field, ValueBase* value) {
+                auto& pending = static_cast<Value<T>*>(value)->value;
+                *const_cast<Field*>(static_cast<Field const*>(field)) = std::move(*pending);
+                pending.reset();
+            },
+            [](ValueBase* value) {
+                delete static_cast<Value<T>*>(value);
+            }
+        };
+
+        /// @brief The pending value of one field. It's queued whenever pending goes from empty to full,
+        /// so it's queued at most once, and only the render thread empties it again.
+        struct Slot final : MutationBase {
+            /// @brief Marks a slot that is claimed or released, users count up from it while they back off
+            static constexpr int locked = INT_MIN / 2;
+
+            std::atomic<void const*> field;
+            std::atomic<FieldOps const*> ops;
+            /// @brief Producers currently writing to the slot
+            std::atomic<int> users;
+            std::atomic<ValueBase*> pending;
+            /// @brief Emptied values for the next writes, so writes don't allocate. Two, since one
+            /// may be waiting in pending while the render thread hands back another.
+            std::array<std::atomic<ValueBase*>, 2> spares;
+
+            // only touched by the render thread
+            uint64_t lastApplied;
+            bool listed;
+
+            Slot() noexcept : field(nullptr), ops(nullptr), users(0), pending(nullptr), spares{nullptr, nullptr}, lastApplied(0), listed(false) {}
+
+            bool apply() override {
+                auto value = pending.exchange(nullptr, std::memory_order_acq_rel);
+                if (!value) return false;
+
+                auto fieldOps = ops.load(std::memory_order_relaxed);
+                fieldOps->assign(field.load(std::memory_order_relaxed), value);
+                recycle(value, fieldOps);
+                visited();
+                return true;
+            }
+
+            void drop() override {
+                if (auto value = pending.exchange(nullptr, std::memory_order_acq_rel)) {
+                    // the value wasn't assigned, so it still holds one
+                    ops.load(std::memory_order_relaxed)->destroy(value);
+                }
+                visited();
+            }
+
+            /// @brief Lists the slot, so it's released once its field isn't written anymore
+            void visited() {
+                lastApplied = drains;
+                if (!listed) {
+                    listed = true;
+                    slots.push_back(this);
+                }
+            }
+
+            /// @brief A spare value, nullptr if there is none
+            ValueBase* takeSpare() noexcept {
+                for (auto& spare : spares) {
+                    if (spare.load(std::memory_order_relaxed)) {
+                        if (auto value = spare.exchange(nullptr, std::memory_order_acquire)) return value;
+                    }
+                }
+                return nullptr;
+            }
+
+            void recycle(ValueBase* value, FieldOps const* fieldOps) noexcept {
+                for (auto& spare : spares) {
+                    ValueBase* empty = nullptr;
+                    if (spare.compare_exchange_strong(empty, value, std::memory_order_release, std::memory_order_relaxed)) return;
+                }
+                fieldOps->destroy(value);
+            }
+
+            enum class Use {
+                Other,
+                Used,
+                /// @brief Belongs to field, but is being claimed or released right now
+                Busy
+            };
+
+            /// @brief Registers a user if the slot belongs to field
+            Use tryUse(void const* address, FieldOps const* fieldOps) noexcept {
+                if (field.load(std::memory_order_acquire) != address || ops.load(std::memory_order_acquire) != fieldOps) return Use::Other;
+                if (users.fetch_add(1, std::memory_order_acq_rel) < 0) {
+                    users.fetch_sub(1, std::memory_order_release);
+                    return Use::Busy;
+                }
+                // it may have been released and claimed by another field in between
+                if (field.load(std::memory_order_acquire) != address || ops.load(std::memory_order_acquire) != fieldOps) {
+                    users.fetch_sub(1, std::memory_order_release);
+                    return Use::Other;
+                }
+                return Use::Used;
+            }
+        };
+
+        template<class T, class Field, class U>
+        static void postWrite(Field& field, U&& value) {
+            auto fieldOps = &opsOf<Field, T>;
+            auto slot = use(&field, fieldOps);
+            if (!slot) {
+                // every slot near this field is taken, so it's written on its own
+                post([&field, value = T(std::forward<U>(value))]() mutable {
+                    field = std::move(value);
+                });
+                return;
+            }
+
+            auto next = static_cast<Value<T>*>(slot->takeSpare());
+            if (!next) next = new Value<T>();
+            next->value.emplace(std::forward<U>(value));
+
+            if (auto replaced = slot->pending.exchange(next, std::memory_order_acq_rel)) {
+                static_cast<Value<T>*>(replaced)->value.reset();
+                slot->recycle(replaced, fieldOps);
+            } else {
+                push(slot);
+            }
+            slot->users.fetch_sub(1, std::memory_order_release);
+        }
+
+        static constexpr size_t probes = 16;
+
+        static size_t firstProbe(void const* address) noexcept {
+            return static_cast<size_t>(detail::mixKey(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(address))));
+        }
+
+        /// @brief The slot of field with one user registered, nullptr if there is no free one
+        static Slot* use(void const* address, FieldOps const* fieldOps) {
+            auto first = firstProbe(address);
+            bool busy = false;
+            auto find = [&]() -> Slot* {
+                busy = false;
+                for (size_t i = 0; i < probes; i++) {
+                    auto& slot = table[(first + i) % slotCount];
+                    switch (slot.tryUse(address, fieldOps)) {
+                        case Slot::Use::Used: return &slot;
+                        case Slot::Use::Busy: busy = true; break;
+                        case Slot::Use::Other: break;
+                    }
+                }
+                return nullptr;
+            };
+            if (auto slot = find()) return slot;
+
+            // Only the first write to a field in a while gets here. Claiming is serialized so a field never gets two slots.
+            std::lock_guard lock(claiming);
+            while (true) {
+                if (auto slot = find()) return slot;
+                // the render thread is deciding whether to release the slot of field, which takes a few instructions
+                if (!busy) break;
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < probes; i++) {
+                auto& slot = table[(first + i) % slotCount];
+                int unused = 0;
+                if (slot.field.load(std::memory_order_acquire) != nullptr ||
+                    !slot.users.compare_exchange_strong(unused, Slot::locked, std::memory_order_acq_rel)) continue;
+
+                slot.ops.store(fieldOps, std::memory_order_relaxed);
+                slot.field.store(address, std::memory_order_release);
+                // unlocks it with this write as its user, users that backed off in between took themselves out again
+                slot.users.fetch_add(1 - Slot::locked, std::memory_order_acq_rel);
+                return &slot;
+            }
+            return nullptr;
+        }
+
+        /// @brief Gives up the slots of fields that weren't written for a while, their field may be gone
+        static void releaseIdleSlots() {
+            std::erase_if(slots, [](Slot* slot) {
+                if (drains - slot->lastApplied < idleDrains) return false;
+
+                int unused = 0;
+                if (!slot->users.compare_exchange_strong(unused, Slot::locked, std::memory_order_acq_rel)) return false;
+                // written again right before it was locked
+                if (slot->pending.load(std::memory_order_acquire)) {
+                    slot->users.fetch_sub(Slot::locked, std::memory_order_release);
+                    return false;
+                }
+
+                while (auto value = slot->takeSpare()) {
+                    slot->ops.load(std::memory_order_relaxed)->destroy(value);
+                }
+                slot->field.store(nullptr, std::memory_order_release);
+                slot->ops.store(nullptr, std::memory_order_release);
+                slot->listed = false;
+                slot->users.fetch_sub(Slot::locked, std::memory_order_release);
+                return true;
+            });
+        }
+
+        // lock free stack, the render thread takes the whole stack at once so there is no ABA problem
+        static void push(MutationBase* node) {
+            node->next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        /// @brief Takes the whole stack, oldest first
+        static MutationBase* takeInOrder() {
+            auto node = head.exchange(nullptr, std::memory_order_acquire);
+            MutationBase* ordered = nullptr;
+            while (node) {
+                auto next = node->next;
+                node->next = ordered;
+                ordered = node;
+                node = next;
+            }
+            return ordered;
+        }
+
+        inline static std::atomic<MutationBase*> head = nullptr;
+        inline static std::array<Slot, slotCount> table;
+        inline static std::mutex claiming;
+        // only touched by the render thread, kept around so draining doesn't allocate once warmed up
+        inline static uint64_t drains = 0;
+        inline static std::vector<Slot*> slots;
+    };
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "context.hpp"
+
+#include "backend.hpp"
+
+#include "UnityEngine/Object.hpp"
+#include "UnityEngine/GameObject.hpp"
+#include "UnityEngine/Transform.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace QUC {
+    /// @brief Counters of a NativePool, useful for checking whether pooling pays off
+    struct NativePoolStats {
+        /// @brief Objects created because the pool had nothing to hand out
+        size_t created = 0;
+        /// @brief Objects handed out again instead of being created
+        size_t reused = 0;
+        /// @brief Objects taken back by the pool
+        size_t released = 0;
+        /// @brief Objects destroyed because the pool was full or cleared
+        size_t destroyed = 0;
+
+        [[nodiscard]] constexpr float hitRate() const noexcept {
+            auto total = created + reused;
+            return total == 0 ? 0.0f : static_cast<float>(reused) / static_cast<float>(total);
+        }
+    };
+
+    namespace detail {
+        /// @brief Inactive object that pooled objects are parented to while unused.
+        /// Survives scene changes, and is recreated if something destroyed it anyway.
+        inline UnityEngine::Transform* getPoolHolder() {
+            static UnityEngine::GameObject* holder = nullptr;
+
+            if (!holder || !holder->m_CachedPtr) {
+                holder = Backend::createObject("QUCPool");
+                holder->SetActive(false);
+                UnityEngine::Object::DontDestroyOnLoad(holder);
+            }
+
+            return holder->get_transform();
+        }
+    }
+
+    /// @brief Keeps unmounted native objects of one component type around, so mounting it again
+    /// reparents an existing object instead of going through QuestUI::BeatSaberUI::Create*.
+    /// Objects created with different arguments that can't be changed afterwards
+    /// (e.g. a button template) are told apart by a variant.
+    /// Components call acquire() before creating, and track() once they have an object.
+    /// RenderContext then releases the object to the pool instead of destroying it.
+    /// Must only be used on the main thread.
+    /// @tparam Tag Usually the component type
+    template<typename Tag>
+    struct NativePool {
+        static constexpr size_t defaultCapacity = 32;
+
+        /// @brief Takes a pooled object and parents it to parent, or returns nullptr if there is none.
+        /// When nullptr is returned, the caller is expected to create the object.
+        static UnityEngine::GameObject* acquire(UnityEngine::Transform* parent, size_t variant = 0) {
+            for (size_t i = entries.size(); i > 0; i--) {
+                auto entry = entries[i - 1];
+                if (entry.variant != variant) continue;
+
+                entries.erase(entries.begin() + static_cast<std::ptrdiff_t>(i - 1));
+                // destroyed while pooled, e.g. by a scene change
+                if (!entry.object->m_CachedPtr) continue;
+
+                QUC_NATIVE_CALL(entry.object->get_transform()->SetParent(parent, false));
+                QUC_NATIVE_CALL(entry.object->SetActive(true));
+                stats.reused++;
+                return entry.object;
+            }
+
+            stats.created++;
+            return nullptr;
+        }
+
+        /// @brief Makes the render context hand object to this pool instead of destroying it
+        static void track(RenderContextChildData& data, UnityEngine::GameObject* object, size_t variant = 0) {
+            data.pooled = {object, variant, &NativePool::release};
+        }
+
+        /// @brief Deactivates object and keeps it for later, or destroys it when the pool is full
+        static void release(UnityEngine::GameObject* object, size_t variant) {
+            if (!object || !object->m_CachedPtr) return;
+
+            if (entries.size() >= capacity) {
+                QUC_NATIVE_CALL(Backend::destroy(object));
+                stats.destroyed++;
+                return;
+            }
+
+            QUC_NATIVE_CALL(object->SetActive(false));
+            QUC_NATIVE_CALL(object->get_transform()->SetParent(detail::getPoolHolder(), false));
+            entries.push_back({object, variant});
+            stats.released++;
+        }
+
+        /// @brief Sets how many objects are kept at most. 0 disables pooling of this type.
+        /// Objects above the new capacity are destroyed.
+        static void setCapacity(size_t newCapacity) {
+            capacity = newCapacity;
+            while (entries.size() > capacity) {
+                destroyEntry(entries.front());
+                entries.erase(entries.begin());
+            }
+        }
+
+        [[nodiscard]] static size_t getCapacity() noexcept {
+            return capacity;
+        }
+
+        [[nodiscard]] static size_t size() noexcept {
+            return entries.size();
+        }
+
+        [[nodiscard]] static NativePoolStats const& getStats() noexcept {
+            return stats;
+        }
+
+        static void resetStats() noexcept {
+            stats = {};
+        }
+
+        /// @brief Destroys every pooled object
+        static void clear() {
+            for (auto const& entry : entries) {
+                destroyEntry(entry);
+            }
+            entries.clear();
+        }
+
+    private:
+        struct Entry {
+            UnityEngine::GameObject* object;
+            size_t variant;
+        };
+
+        static void destroyEntry(Entry const& entry) {
+            if (entry.object->m_CachedPtr) {
+                QUC_NATIVE_CALL(Backend::destroy(entry.object));
+                stats.destroyed++;
+            }
+        }
+
+        inline static std::vector<Entry> entries;
+        inline static size_t capacity = defaultCapacity;
+        inline static NativePoolStats stats;
+    };
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+/// Opt-in render profiler. Define QUC_PROFILING before including any QUC header to compile it in,
+/// otherwise every macro in here expands to nothing (or to the wrapped expression) and costs nothing.
+///
+/// Records one event per rendered component (split into create and update), per assign() and per
+/// QUC_PROFILE_SCOPE, together with the amount of native calls made inside of it.
+/// Events go to a fixed size ring buffer, which can be written out as a Chrome trace
+/// (chrome://tracing or https://ui.perfetto.dev).
+
+#ifdef QUC_PROFILING
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#ifndef QUC_PROFILING_CAPACITY
+#define QUC_PROFILING_CAPACITY 16384
+#endif
+
+namespace QUC::Profiler {
+    enum class EventKind : uint8_t {
+        Create,
+        Update,
+        Scope
+    };
+
+    struct Event {
+        std::string_view name;
+        uint64_t startNs;
+        uint64_t durationNs;
+        /// @brief Native calls made while the event was open, including nested events
+        uint32_t nativeCalls;
+        uint32_t threadId;
+        EventKind kind;
+    };
+
+    namespace detail {
+        struct State {
+            static constexpr size_t capacity = QUC_PROFILING_CAPACITY;
+            static_assert((capacity & (capacity - 1)) == 0, "QUC_PROFILING_CAPACITY must be a power of two");
+
+            std::array<Event, capacity> events;
+            /// @brief Amount of events ever recorded, the oldest ones get overwritten
+            size_t recorded = 0;
+            bool enabled = true;
+        };
+
+        inline State& state() {
+            static State s;
+            return s;
+        }
+
+        inline thread_local uint32_t nativeCalls = 0;
+
+        inline uint64_t now() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        inline uint32_t threadId() noexcept {
+            return static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        }
+
+        /// @brief Name of T without going through RTTI, e.g. "QUC::Text"
+        template<typename T>
+        constexpr std::string_view typeName() noexcept {
+            std::string_view name = __PRETTY_FUNCTION__;
+            auto start = name.find("T = ") + 4;
+            auto end = name.find_first_of(";]", start);
+            return name.substr(start, end - start);
+        }
+
+        /// @brief Writes ns as microseconds with three decimals, without touching the stream's formatting
+        inline void writeMicros(std::ostream& out, uint64_t ns) {
+            auto fraction = ns % 1000;
+            out << ns / 1000 << '.' << static_cast<char>('0' + fraction / 100) << static_cast<char>('0' + fraction / 10 % 10) << static_cast<char>('0' + fraction % 10);
+        }
+
+        inline void writeEscaped(std::ostream& out, std::string_view str) {
+            for (char c : str) {
+                if (c == '"' || c == '\\') out << '\\';
+                out << c;
+            }
+        }
+    }
+
+    /// @brief Records an event from construction until destruction.
+    /// Events are only recorded from the thread that renders, the buffer is not synchronized.
+    struct Scope {
+        Scope(std::string_view name, EventKind kind = EventKind::Scope) noexcept
+            : name(name), kind(kind), active(detail::state().enabled) {
+            if (!active) return;
+            startCalls = detail::nativeCalls;
+            startNs = detail::now();
+        }
+
+        Scope(Scope const&) = delete;
+
+        ~Scope() {
+            if (!active) return;
+
+            auto endNs = detail::now();
+            auto& state = detail::state();
+            state.events[state.recorded & (detail::State::capacity - 1)] = {
+                    name, startNs, endNs - startNs, detail::nativeCalls - startCalls, detail::threadId(), kind
+            };
+            state.recorded++;
+        }
+
+    private:
+        std::string_view name;
+        EventKind kind;
+        bool active;
+        uint32_t startCalls = 0;
+        uint64_t startNs = 0;
+    };
+
+    inline void countNativeCall() noexcept {
+        detail::nativeCalls++;
+    }
+
+    /// @brief Pauses or resumes recording. Recording is on by default when compiled in.
+    inline void setEnabled(bool enabled) noexcept {
+        detail::state().enabled = enabled;
+    }
+
+    [[nodiscard]] inline bool isEnabled() noexcept {
+        return detail::state().enabled;
+    }
+
+    /// @brief Drops all recorded events
+    inline void clear() noexcept {
+        detail::state().recorded = 0;
+    }
+
+    /// @brief Calls f(Event const&) for every event still in the buffer, oldest first
+    template<typename F>
+    void forEach(F&& f) {
+        auto& state = detail::state();
+        size_t count = std::min(state.recorded, detail::State::capacity);
+        for (size_t i = state.recorded - count; i < state.recorded; i++) {
+            f(std::as_const(state.events[i & (detail::State::capacity - 1)]));
+        }
+    }
+
+    /// @brief Writes the buffer as Chrome trace event JSON
+    inline void writeChromeTrace(std::ostream& out) {
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        forEach([&](Event const& event) {
+            if (!first) out << ',';
+            first = false;
+
+            out << "{\"name\":\"";
+            detail::writeEscaped(out, event.name);
+            out << "\",\"cat\":\"";
+            switch (event.kind) {
+                case EventKind::Create: out << "create"; break;
+                case EventKind::Update: out << "update"; break;
+                case EventKind::Scope: out << "scope"; break;
+            }
+            out << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.threadId << ",\"ts\":";
+            detail::writeMicros(out, event.startNs);
+            out << ",\"dur\":";
+            detail::writeMicros(out, event.durationNs);
+            out << ",\"args\":{\"nativeCalls\":" << event.nativeCalls << "}}";
+        });
+        out << "]}";
+    }
+}
+
+#define QUC_PROFILE_CONCAT_INNER(a, b) a##b
+#define QUC_PROFILE_CONCAT(a, b) QUC_PROFILE_CONCAT_INNER(a, b)
+
+/// @brief Records the rest of the enclosing block as an event called name
+#define QUC_PROFILE_SCOPE(name) ::QUC::Profiler::Scope QUC_PROFILE_CONCAT(qucProfileScope, __LINE__)(name)
+/// @brief Records the render of component type T, as create if its child data holds no state yet
+#define QUC_PROFILE_RENDER(T, data) ::QUC::Profiler::Scope QUC_PROFILE_CONCAT(qucProfileScope, __LINE__)(::QUC::Profiler::detail::typeName<T>(), (data).childData.has_value() ? ::QUC::Profiler::EventKind::Update : ::QUC::Profiler::EventKind::Create)
+/// @brief Evaluates to the wrapped expression, counting it as a native call
+#define QUC_NATIVE_CALL(...) (::QUC::Profiler::countNativeCall(), __VA_ARGS__)
+
+#else
+
+#define QUC_PROFILE_SCOPE(name) static_cast<void>(0)
+#define QUC_PROFILE_RENDER(T, data) static_cast<void>(0)
+#define QUC_NATIVE_CALL(...) (__VA_ARGS__)
+
+#endif
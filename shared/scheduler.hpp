@@ -0,0 +1,146 @@
+#pragma once
+
+#include "context.hpp"
+#include "backend.hpp"
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+
+namespace QUC {
+    /// @brief Coalesces render requests and flushes them on the main thread once per frame.
+    /// Requesting the same component on the same context several times before it is rendered only renders it once.
+    /// Each flush stops once it ran over the frame budget, and the remaining requests are rendered on the next frame.
+    /// Requests may come from any thread. Components and contexts must stay alive until their request is
+    /// rendered or cancelled, so cancel(ctx) before destroying a context that may have pending requests.
+    struct RenderScheduler {
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief Renders component on ctx during one of the next frames
+        template<class T>
+        requires (renderable<T>)
+        static void request(T& component, RenderContext& ctx) {
+            request(&component, ctx, [](void* component, RenderContext& ctx) {
+                detail::renderSingle(*static_cast<T*>(component), ctx);
+            });
+        }
+
+        /// @brief Calls render(component, ctx) during one of the next frames, for callers that don't know the type of component
+        static void request(void* component, RenderContext& ctx, void (*render)(void* component, RenderContext& ctx)) {
+            std::lock_guard lock(mutex);
+            if (!requested.insert({component, &ctx}).second) return;
+
+            queue.push_back({component, &ctx, render});
+            scheduleFlush();
+        }
+
+        /// @brief Drops pending requests of component
+        static void cancel(void const* component) {
+            cancelIf([component](Request const& request) { return request.component == component; });
+        }
+
+        /// @brief Drops pending requests that render on ctx
+        static void cancel(RenderContext const& ctx) {
+            cancelIf([&ctx](Request const& request) { return request.ctx == &ctx; });
+        }
+
+        /// @brief Renders pending requests until the budget is used up. Called once per frame on the main thread.
+        /// Requests made while flushing are rendered on the next frame.
+        /// @return The amount of rendered requests
+        static size_t flush() {
+            size_t available;
+            {
+                std::lock_guard lock(mutex);
+                flushScheduled = false;
+                available = queue.size();
+            }
+
+            auto start = Clock::now();
+            size_t rendered = 0;
+            // always render at least one request, so a request over budget can't stall the queue
+            while (rendered < available) {
+                Request request;
+                {
+                    std::lock_guard lock(mutex);
+                    // cancelled while rendering the previous one
+                    if (queue.empty()) break;
+
+                    request = queue.front();
+                    queue.pop_front();
+                    requested.erase({request.component, request.ctx});
+                }
+
+                request.render(request.component, *request.ctx);
+                rendered++;
+
+                if (Clock::now() - start >= budget) break;
+            }
+
+            std::lock_guard lock(mutex);
+            if (!queue.empty()) scheduleFlush();
+            return rendered;
+        }
+
+        /// @brief Sets how long a flush may render each frame
+        static void setBudget(Clock::duration newBudget) noexcept {
+            budget = newBudget;
+        }
+
+        [[nodiscard]] static Clock::duration getBudget() noexcept {
+            return budget;
+        }
+
+        [[nodiscard]] static size_t pending() {
+            std::lock_guard lock(mutex);
+            return queue.size();
+        }
+
+    private:
+        struct Request {
+            void* component;
+            RenderContext* ctx;
+            void(*render)(void* component, RenderContext& ctx);
+        };
+
+        struct RequestKey {
+            void const* component;
+            RenderContext const* ctx;
+
+            bool operator==(RequestKey const&) const = default;
+        };
+
+        struct RequestKeyHash {
+            size_t operator()(RequestKey const& key) const noexcept {
+                return detail::hashPointers(key.component, key.ctx);
+            }
+        };
+
+        template<typename F>
+        static void cancelIf(F&& pred) {
+            std::lock_guard lock(mutex);
+            std::erase_if(queue, [&](Request const& request) {
+                if (!pred(request)) return false;
+                requested.erase({request.component, request.ctx});
+                return true;
+            });
+        }
+
+        // mutex must be held
+        static void scheduleFlush() {
+            if (flushScheduled) return;
+            flushScheduled = true;
+            Backend::scheduleOnMainThread([] {
+                flush();
+            });
+        }
+
+        // 90hz leaves ~11ms per frame, most of which the game needs
+        inline static Clock::duration budget = std::chrono::milliseconds(2);
+
+        inline static std::mutex mutex;
+        inline static std::deque<Request> queue;
+        inline static std::unordered_set<RequestKey, RequestKeyHash> requested;
+        inline static bool flushScheduled = false;
+    };
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "context.hpp"
+#include "scheduler.hpp"
+#include "function.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace QUC {
+    namespace detail {
+        /// @brief What Signal and Computed share: who read the value, and telling them once it changed.
+        /// Components that read it during render are marked dirty, and the outermost component they were rendered
+        /// from is rendered again by the RenderScheduler, which only visits the dirty components.
+        /// Computed values that read it while computing are recomputed.
+        /// A component stays subscribed until it is forgotten (destroyed, swept or moved), so one that stopped
+        /// reading the value may still be rendered again when it changes.
+        /// Only used from the render thread.
+        struct ReactiveNode : Dependency {
+            ReactiveNode() = default;
+            // subscribers remember the address
+            ReactiveNode(ReactiveNode const&) = delete;
+            ReactiveNode& operator=(ReactiveNode const&) = delete;
+
+            void forgetReader(RenderContextChildData const& reader) noexcept override {
+                readers.erase(&reader);
+            }
+
+        protected:
+            ~ReactiveNode() {
+                for (auto const& [reader, root] : readers) {
+                    DirtyTracker::removeDependency(*reader, this);
+                }
+                for (auto node : derived) {
+                    std::erase(node->sources, this);
+                }
+                for (auto node : sources) {
+                    std::erase(node->derived, this);
+                }
+            }
+
+            /// @brief Subscribes whoever reads the value right now: the computed value being computed, or else the rendering component
+            void track() const {
+                auto self = const_cast<ReactiveNode*>(this);
+                if (computing) {
+                    if (std::find(derived.begin(), derived.end(), computing) == derived.end()) {
+                        derived.push_back(computing);
+                        computing->sources.push_back(self);
+                    }
+                    return;
+                }
+
+                auto frame = DirtyTracker::current;
+                if (!frame) return;
+
+                auto reader = frame->data;
+                while (frame->parent) {
+                    frame = frame->parent;
+                }
+                Root root{const_cast<void*>(frame->data->component), frame->ctx, frame->render};
+
+                auto [it, inserted] = readers.try_emplace(reader, root);
+                if (inserted) {
+                    DirtyTracker::addDependency(*reader, self);
+                } else {
+                    // the same component may be rendered from another root now
+                    it->second = root;
+                }
+            }
+
+            /// @brief Renders the components that read the value again, and recomputes the values computed from it
+            void notify() {
+                // once per batch, see QUC::Batch
+                if (BatchState::defer(this, nullptr, [](void* node, RenderContext*) { static_cast<ReactiveNode*>(node)->notify(); })) return;
+
+                for (auto const& [reader, root] : readers) {
+                    DirtyTracker::markDirty(*const_cast<RenderContextChildData*>(reader));
+                    RenderScheduler::request(root.component, *root.ctx, root.render);
+                }
+                // recomputing may subscribe more values to this one, so no iterators
+                for (size_t i = 0; i < derived.size(); i++) {
+                    derived[i]->sourceChanged();
+                }
+            }
+
+            [[nodiscard]] bool observed() const noexcept {
+                return !readers.empty() || !derived.empty();
+            }
+
+            /// @brief Called when a value read by the last computation changed, see Computed
+            virtual void sourceChanged() {}
+
+            /// @brief The computed value that is currently being computed
+            inline static ReactiveNode* computing = nullptr;
+
+        private:
+            struct Root {
+                void* component;
+                RenderContext* ctx;
+                void (*render)(void* component, RenderContext& ctx);
+            };
+
+            mutable std::unordered_map<RenderContextChildData const*, Root> readers;
+            mutable std::vector<ReactiveNode*> derived;
+            std::vector<ReactiveNode*> sources;
+        };
+    }
+
+    /// @brief State that lives outside of the tree and may be shown by any amount of components.
+    /// Components that read it during render (with *, -> or get()) are rendered again when it changes,
+    /// without rendering anything else: writing it marks those components dirty and renders their tree
+    /// through the RenderScheduler on the next frame, which skips every component that didn't read it.
+    /// The components and contexts they were rendered from must stay alive like for RenderScheduler::request.
+    /// Like HeldData, assigning an equal value does nothing.
+    /// Must only be used on the main thread, post writes from other threads with MutationQueue::post.
+    template<typename T>
+    struct Signal : detail::ReactiveNode {
+        Signal() = default;
+        Signal(T value) : value(std::move(value)) {}
+
+        [[nodiscard]] T const& get() const {
+            track();
+            return value;
+        }
+
+        T const& operator*() const {
+            return get();
+        }
+
+        T const* operator->() const {
+            return &get();
+        }
+
+        /// @brief The value, without subscribing the rendering component to it
+        [[nodiscard]] T const& peek() const noexcept {
+            return value;
+        }
+
+        template<class U>
+        requires (std::is_assignable_v<T&, U&&>)
+        Signal& operator=(U&& next) {
+            set(std::forward<U>(next));
+            return *this;
+        }
+
+        template<class U>
+        requires (std::is_assignable_v<T&, U&&>)
+        void set(U&& next) {
+            if constexpr (std::equality_comparable_with<T const&, U const&>) {
+                if (value == next) return;
+            }
+            value = std::forward<U>(next);
+            notify();
+        }
+
+        /// @brief Calls f with the value to change it in place, then renders whoever read it. Returns what f returns.
+        template<class F>
+        requires (std::is_invocable_v<F&, T&>)
+        decltype(auto) modify(F&& f) {
+            if constexpr (std::is_void_v<std::invoke_result_t<F&, T&>>) {
+                f(value);
+                notify();
+            } else {
+                decltype(auto) result = f(value);
+                notify();
+                return result;
+            }
+        }
+
+    private:
+        T value;
+    };
+
+    /// @brief A value computed from signals or other computed values, and only recomputed once one of them changes.
+    /// Components read it like a Signal. When a value it depends on changes and it is being read by anyone, it is
+    /// recomputed right away, and only renders its readers again if the result changed.
+    /// Otherwise it is recomputed the next time it is read.
+    /// Must only be used on the main thread.
+    template<typename T>
+    struct Computed : detail::ReactiveNode {
+        template<class F>
+        requires (std::is_invocable_r_v<T, F&>)
+        explicit Computed(F&& f) : compute(std::forward<F>(f)) {}
+
+        [[nodiscard]] T const& get() const {
+            track();
+            if (!value) {
+                value.emplace(evaluate());
+            }
+            return *value;
+        }
+
+        T const& operator*() const {
+            return get();
+        }
+
+        T const* operator->() const {
+            return &get();
+        }
+
+    protected:
+        void sourceChanged() override {
+            if (!observed()) {
+                // nobody to tell, recompute once someone asks
+                value.reset();
+                return;
+            }
+
+            auto next = evaluate();
+            if constexpr (std::equality_comparable<T>) {
+                if (value && *value == next) return;
+            }
+            value = std::move(next);
+            notify();
+        }
+
+    private:
+        T evaluate() const {
+            struct Restore {
+                ReactiveNode* outer;
+                ~Restore() {
+                    computing = outer;
+                }
+            } restore{computing};
+            computing = const_cast<Computed*>(this);
+
+            return compute();
+        }
+
+        UniqueFunction<T()> compute;
+        mutable std::optional<T> value;
+    };
+}
@@ -6,6 +6,13 @@
 #include <string>
 #include <type_traits>
 #include <optional>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "dirty.hpp"
 
 namespace QUC {
 
@@ -19,7 +26,7 @@ namespace QUC {
         {t.isModified()} noexcept -> std::same_as<bool>;
         {t.getData()} noexcept;// -> std::convertible_to<T>;
         {*t} noexcept; //-> std::same_as<T const&>;
-        {t.operator ->} noexcept; // -> std::convertible_to<T const&>;
+        {t.operator->()} noexcept; // -> std::convertible_to<T const&>;
         {(bool) t};
 
         std::is_default_constructible_v<T>;
@@ -29,11 +36,123 @@ namespace QUC {
         {t.clear()} noexcept;
     };
 
+    namespace detail {
+        /// @brief A version no other Versioned value had before
+        inline uint64_t nextVersion() noexcept {
+            static std::atomic<uint64_t> counter = 0;
+            return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+    }
+
+    /// @brief Opts large values (lists, maps, long strings) of HeldData and TrackedData into O(1) change detection.
+    /// Every new value gets a new version, and two Versioned values compare equal when their versions do,
+    /// without looking at their contents. Copies keep the version, so assigning a copy of the current value does nothing,
+    /// while assigning a plain T always counts as a change, even if its contents are the same:
+    /// ```cpp
+    /// HeldData<Versioned<std::vector<std::string>>> rows;
+    /// rows = loadRows();                                    // modified, no element compared
+    /// rows.modify([](auto& list) { list.push_back("x"); }); // modified, new version
+    /// rows->size();
+    /// ```
+    /// Components can remember getVersion() of what they last showed and skip the work if it didn't change.
+    template<class T>
+    struct Versioned {
+        Versioned() : version(detail::nextVersion()) {}
+
+        template<class... Args>
+        requires (sizeof...(Args) > 0 && std::is_constructible_v<T, Args&&...> &&
+                  !(sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, Versioned> && ...)))
+        explicit(sizeof...(Args) != 1) Versioned(Args&&... args) : value(std::forward<Args>(args)...), version(detail::nextVersion()) {}
+
+        Versioned(Versioned const&) = default;
+        Versioned& operator=(Versioned const&) = default;
+
+        // the moved from value is empty, so it mustn't compare equal to the moved one
+        Versioned(Versioned&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+                : value(std::move(other.value)), version(std::exchange(other.version, detail::nextVersion())) {}
+
+        Versioned& operator=(Versioned&& other) noexcept(std::is_nothrow_move_assignable_v<T>) {
+            value = std::move(other.value);
+            version = std::exchange(other.version, detail::nextVersion());
+            return *this;
+        }
+
+        [[nodiscard]] T const& get() const noexcept {
+            return value;
+        }
+
+        explicit(false) operator T const&() const noexcept {
+            return value;
+        }
+
+        T const& operator*() const noexcept {
+            return value;
+        }
+
+        T const* operator->() const noexcept {
+            return &value;
+        }
+
+        [[nodiscard]] uint64_t getVersion() const noexcept {
+            return version;
+        }
+
+        /// @brief Changes the value in place through f(T&), which makes it a new version
+        template<class F>
+        requires (std::is_invocable_v<F&&, T&>)
+        decltype(auto) modify(F&& f) {
+            version = detail::nextVersion();
+            return std::forward<F>(f)(value);
+        }
+
+        friend bool operator==(Versioned const& a, Versioned const& b) noexcept {
+            return a.version == b.version;
+        }
+
+        // a plain value is always new
+        friend bool operator==(Versioned const&, T const&) noexcept {
+            return false;
+        }
+
+    private:
+        T value;
+        uint64_t version;
+    };
+
+    namespace detail {
+        /// @brief What modify hands to its callback: the held value, or the value inside a Versioned
+        template<class T>
+        struct ModifiedValue {
+            using type = T;
+            static constexpr bool versioned = false;
+        };
+
+        template<class T>
+        struct ModifiedValue<Versioned<T>> {
+            using type = T;
+            static constexpr bool versioned = true;
+        };
+
+        /// @brief Calls f with the value to change, unwrapping Versioned values so they get a new version
+        template<class T, class F>
+        constexpr decltype(auto) modifyValue(T& data, F&& f) {
+            if constexpr (ModifiedValue<T>::versioned) {
+                return data.modify(std::forward<F>(f));
+            } else {
+                return std::forward<F>(f)(data);
+            }
+        }
+    }
+
     template<class T>
     struct HeldData {
         HeldData() = default;
+        // declared, since the assignment operators below would otherwise turn moves into copies
+        HeldData(HeldData const&) = default;
+        HeldData(HeldData&&) noexcept(std::is_nothrow_move_constructible_v<T>) = default;
 
-        constexpr HeldData(T const&) : data(data) {}
+        constexpr HeldData(T const& data) : data(data) {}
+        constexpr HeldData(T&& data) : data(std::move(data)) {}
 
         template<class U>
         requires (std::is_convertible_v<U, T>)
@@ -41,7 +160,7 @@ namespace QUC {
 
         template<class Q>
         requires (std::is_convertible_v<Q, T>)
-        constexpr explicit(false) HeldData(Q&& arg) : data(arg) {}
+        constexpr explicit(false) HeldData(Q&& arg) : data(std::forward<Q>(arg)) {}
 
         constexpr explicit(false) operator T () const noexcept {return data;}
         constexpr explicit(false) operator T const&() const noexcept {return data;}
@@ -61,6 +180,7 @@ namespace QUC {
         constexpr HeldData<T>& operator=(const T& other) {
             if (data != other) {
                 modified = true;
+                detail::markWritten(this);
                 data = other;
             }
             return *this;
@@ -69,6 +189,7 @@ namespace QUC {
         constexpr HeldData<T>& operator=(const HeldData<T>& other) {
             if (data != other.data) {
                 modified = true;
+                detail::markWritten(this);
                 data = other.data;
             }
             return *this;
@@ -78,6 +199,7 @@ namespace QUC {
         constexpr HeldData<T>& operator=(const HeldData<U>& other) {
             if (data != other.data) {
                 modified = true;
+                detail::markWritten(this);
                 data = other.data;
             }
             return *this;
@@ -87,6 +209,7 @@ namespace QUC {
         constexpr HeldData<T>& operator=(const U& other) {
             if (data != other) {
                 modified = true;
+                detail::markWritten(this);
                 data = other;
             }
             return *this;
@@ -100,6 +223,47 @@ namespace QUC {
             return data;
         }
 
+        constexpr HeldData<T>& operator=(T&& other) {
+            if (data != other) {
+                modified = true;
+                detail::markWritten(this);
+                data = std::move(other);
+            }
+            return *this;
+        }
+
+        constexpr HeldData<T>& operator=(HeldData<T>&& other) {
+            return *this = std::move(other.data);
+        }
+
+        /// @brief Moves a plain value into a Versioned one, which always counts as a modification
+        template<class U>
+        requires (detail::ModifiedValue<T>::versioned && std::is_same_v<U, typename detail::ModifiedValue<T>::type>)
+        constexpr HeldData<T>& operator=(U&& other) {
+            modify([&](U& value) { value = std::move(other); });
+            return *this;
+        }
+
+        /// @brief Replaces the value with one constructed from args, without comparing it to the current one
+        template<class... Args>
+        requires (std::is_constructible_v<T, Args&&...>)
+        constexpr T& emplace(Args&&... args) {
+            modified = true;
+            detail::markWritten(this);
+            data = T(std::forward<Args>(args)...);
+            return data;
+        }
+
+        /// @brief Changes the value in place through f(T&), e.g. appending to a list without copying it.
+        /// Always counts as a modification. A Versioned value hands f the value inside it, and gets a new version.
+        template<class F>
+        requires (std::is_invocable_v<F&&, typename detail::ModifiedValue<T>::type&>)
+        constexpr decltype(auto) modify(F&& f) {
+            modified = true;
+            detail::markWritten(this);
+            return detail::modifyValue(data, std::forward<F>(f));
+        }
+
     private:
         bool modified = false;
         T data;
@@ -109,13 +273,16 @@ namespace QUC {
     template<class T>
     struct HeldData<std::optional<T>> {
         HeldData() = default;
+        HeldData(HeldData const&) = default;
+        HeldData(HeldData&&) noexcept(std::is_nothrow_move_constructible_v<T>) = default;
 
         constexpr HeldData(T const& data) : data(data) {}
         constexpr HeldData(std::optional<T> const& data) : data(data) {}
+        constexpr HeldData(std::optional<T>&& data) : data(std::move(data)) {}
 
         template<class U>
         requires (std::is_convertible_v<U, T>)
-        constexpr explicit(false) HeldData(const std::optional<U>& other) : data(data) {}
+        constexpr explicit(false) HeldData(const std::optional<U>& other) : data(other) {}
 
 
         template<class U>
@@ -124,7 +291,7 @@ namespace QUC {
 
         template<class Q>
         requires (std::is_convertible_v<Q, T>)
-        constexpr explicit(false) HeldData(Q&& arg) : data(arg) {}
+        constexpr explicit(false) HeldData(Q&& arg) : data(std::forward<Q>(arg)) {}
 
         constexpr explicit(false) operator std::optional<T> () const noexcept {return data;}
         constexpr explicit(false) operator std::optional<T> const&() const noexcept {return data;}
@@ -144,6 +311,7 @@ namespace QUC {
         constexpr HeldData<std::optional<T>>& operator=(const T& other) {
             if (data != other) {
                 modified = true;
+                detail::markWritten(this);
                 data = other;
             }
             return *this;
@@ -152,6 +320,7 @@ namespace QUC {
         constexpr HeldData<std::optional<T>>& operator=(const HeldData<T>& other) {
             if (data != other.data) {
                 modified = true;
+                detail::markWritten(this);
                 data = other.data;
             }
             return *this;
@@ -160,6 +329,7 @@ namespace QUC {
         constexpr HeldData<std::optional<T>>& operator=(const std::optional<T>& other) {
             if (data != other) {
                 modified = true;
+                detail::markWritten(this);
                 data = other;
             }
             return *this;
@@ -168,6 +338,7 @@ namespace QUC {
         constexpr HeldData<std::optional<T>>& operator=(const HeldData<std::optional<T>>& other) {
             if (data != other.data) {
                 modified = true;
+                detail::markWritten(this);
                 data = other.data;
             }
             return *this;
@@ -178,6 +349,7 @@ namespace QUC {
         constexpr HeldData<std::optional<T>>& operator=(const HeldData<U>& other) {
             if (data != other.data) {
                 modified = true;
+                detail::markWritten(this);
                 data = other.data;
             }
             return *this;
@@ -188,6 +360,7 @@ namespace QUC {
         constexpr HeldData<std::optional<T>>& operator=(const std::optional<U>& other) {
             if (data != other) {
                 modified = true;
+                detail::markWritten(this);
                 data = other;
             }
             return *this;
@@ -198,6 +371,7 @@ namespace QUC {
         constexpr HeldData<std::optional<T>>& operator=(const U& other) {
             if (data != other) {
                 modified = true;
+                detail::markWritten(this);
                 data = other;
             }
             return *this;
@@ -208,6 +382,7 @@ namespace QUC {
         constexpr HeldData<std::optional<T>>& operator=(const HeldData<std::optional<U>>& other) {
             if (data != other.data) {
                 modified = true;
+                detail::markWritten(this);
                 data = other.data;
             }
             return *this;
@@ -222,6 +397,37 @@ namespace QUC {
             return data;
         }
 
+        constexpr HeldData<std::optional<T>>& operator=(std::optional<T>&& other) {
+            if (data != other) {
+                modified = true;
+                detail::markWritten(this);
+                data = std::move(other);
+            }
+            return *this;
+        }
+
+        constexpr HeldData<std::optional<T>>& operator=(HeldData<std::optional<T>>&& other) {
+            return *this = std::move(other.data);
+        }
+
+        /// @brief Like HeldData<T>::emplace, constructing the optional's value
+        template<class... Args>
+        requires (std::is_constructible_v<T, Args&&...>)
+        constexpr T& emplace(Args&&... args) {
+            modified = true;
+            detail::markWritten(this);
+            return data.emplace(std::forward<Args>(args)...);
+        }
+
+        /// @brief Like HeldData<T>::modify
+        template<class F>
+        requires (std::is_invocable_v<F&&, std::optional<T>&>)
+        constexpr decltype(auto) modify(F&& f) {
+            modified = true;
+            detail::markWritten(this);
+            return std::forward<F>(f)(data);
+        }
+
     private:
         bool modified = false;
         std::optional<T> data;
@@ -232,6 +438,8 @@ namespace QUC {
     template<>
     struct HeldData<bool> {
         HeldData() = default;
+        HeldData(HeldData const&) = default;
+        HeldData(HeldData&&) noexcept = default;
 
         constexpr HeldData(bool data) : data(data) {};
 
@@ -252,6 +460,7 @@ namespace QUC {
         constexpr HeldData<bool>& operator=(const HeldData<bool>& other) {
             if (data != other.data) {
                 modified = true;
+                detail::markWritten(this);
                 data = other.data;
             }
             return *this;
@@ -260,6 +469,7 @@ namespace QUC {
         constexpr HeldData<bool>& operator=(bool other) {
             if (data != other) {
                 modified = true;
+                detail::markWritten(this);
                 data = other;
             }
             return *this;
@@ -273,6 +483,15 @@ namespace QUC {
             return data;
         }
 
+        /// @brief Like HeldData<T>::modify
+        template<class F>
+        requires (std::is_invocable_v<F&&, bool&>)
+        constexpr decltype(auto) modify(F&& f) {
+            modified = true;
+            detail::markWritten(this);
+            return std::forward<F>(f)(data);
+        }
+
     private:
         bool modified = false;
         bool data;
@@ -282,8 +501,11 @@ namespace QUC {
     template<>
     struct HeldData<std::string> {
         HeldData() = default;
+        HeldData(HeldData const&) = default;
+        HeldData(HeldData&&) noexcept = default;
 
         explicit(false) HeldData(const std::string_view d) : data(d) {}
+        explicit(false) HeldData(std::string&& d) : data(std::move(d)) {}
 
         template<size_t sz>
         constexpr explicit(false) HeldData(const char (&str)[sz]) : data(str) {}
@@ -310,6 +532,7 @@ namespace QUC {
         constexpr HeldData<std::string>& operator=(const std::string_view other) {
             if (data != other) {
                 modified = true;
+                detail::markWritten(this);
                 data = other;
             }
             return *this;
@@ -318,6 +541,7 @@ namespace QUC {
         constexpr HeldData<std::string>& operator=(const HeldData<std::string>& other) {
             if (data != other.data) {
                 modified = true;
+                detail::markWritten(this);
                 data = other.data;
             }
             return *this;
@@ -327,6 +551,7 @@ namespace QUC {
         constexpr HeldData<std::string>& operator=(const HeldData<U>& other) {
             if (data != other.data) {
                 modified = true;
+                detail::markWritten(this);
                 data = other.data;
             }
             return *this;
@@ -337,6 +562,7 @@ namespace QUC {
         constexpr HeldData<std::string>& operator=(const U& other) {
             if (data != other) {
                 modified = true;
+                detail::markWritten(this);
                 data = other;
             }
             return *this;
@@ -350,9 +576,211 @@ namespace QUC {
             return data;
         }
 
+        constexpr HeldData<std::string>& operator=(std::string&& other) {
+            if (data != other) {
+                modified = true;
+                detail::markWritten(this);
+                data = std::move(other);
+            }
+            return *this;
+        }
+
+        constexpr HeldData<std::string>& operator=(HeldData<std::string>&& other) {
+            return *this = std::move(other.data);
+        }
+
+        /// @brief Like HeldData<T>::emplace
+        template<class... Args>
+        requires (std::is_constructible_v<std::string, Args&&...>)
+        constexpr std::string& emplace(Args&&... args) {
+            modified = true;
+            detail::markWritten(this);
+            data = std::string(std::forward<Args>(args)...);
+            return data;
+        }
+
+        /// @brief Like HeldData<T>::modify
+        template<class F>
+        requires (std::is_invocable_v<F&&, std::string&>)
+        constexpr decltype(auto) modify(F&& f) {
+            modified = true;
+            detail::markWritten(this);
+            return std::forward<F>(f)(data);
+        }
+
     private:
         bool modified = false;
         std::string data;
     };
     static_assert(HeldDataCheck<HeldData<std::string>>);
-}
\ No newline at end of file
+
+    /// @brief The modified bits of all TrackedData fields of one component, packed into a single integer.
+    /// @tparam fieldCount Amount of tracked fields, at most 64
+    template<size_t fieldCount>
+    struct ModifiedMask {
+        static_assert(fieldCount > 0 && fieldCount <= 64, "a component tracks between 1 and 64 fields");
+
+        using Bits = std::conditional_t<(fieldCount <= 8), uint8_t,
+                     std::conditional_t<(fieldCount <= 16), uint16_t,
+                     std::conditional_t<(fieldCount <= 32), uint32_t, uint64_t>>>;
+
+        Bits bits = 0;
+
+        /// @brief Whether any tracked field was modified, a single compare
+        [[nodiscard]] constexpr bool any() const noexcept {
+            return bits != 0;
+        }
+
+        [[nodiscard]] constexpr bool test(size_t bit) const noexcept {
+            return (bits >> bit) & 1;
+        }
+
+        constexpr void set(size_t bit) noexcept {
+            bits |= static_cast<Bits>(Bits(1) << bit);
+        }
+
+        constexpr void reset(size_t bit) noexcept {
+            bits &= static_cast<Bits>(~(Bits(1) << bit));
+        }
+
+        constexpr void clear() noexcept {
+            bits = 0;
+        }
+
+        /// @brief Calls f(size_t bit) for each modified field, lowest bit first.
+        /// Iterates the bits set when called, so f may clear them.
+        template<typename F>
+        constexpr void forEach(F&& f) const {
+            for (auto remaining = bits; remaining != 0; remaining &= static_cast<Bits>(remaining - 1)) {
+                f(static_cast<size_t>(std::countr_zero(remaining)));
+            }
+        }
+    };
+
+    /// @brief A HeldData whose modified flag is a bit in the ModifiedMask of the component holding it, instead of a bool of its own.
+    /// The component declares a `modified` mask covering all of its tracked fields, and says where each field lives:
+    /// ```cpp
+    /// struct Label {
+    ///     ModifiedMask<2> modified;
+    ///     TrackedData<std::string, Label, 0> text;
+    ///     TrackedData<float, Label, 1> size;
+    ///     const Key key;
+    ///
+    ///     static constexpr size_t trackedOffset(size_t bit) {
+    ///         return std::array{offsetof(Label, text), offsetof(Label, size)}[bit];
+    ///     }
+    /// };
+    /// ```
+    /// Checking whether anything changed is then a single compare (`modified.any()`), and assign can
+    /// only visit the fields that changed with `modified.forEach`. Only usable as a member of Owner, which has to be
+    /// standard layout (e.g. no data members with different access, or in both a base and the class), since offsetof
+    /// isn't guaranteed to work otherwise.
+    /// @tparam bit Index of the field in Owner::modified
+    template<class T, class Owner, size_t bit>
+    struct TrackedData {
+        /// @brief The bit of this field in Owner::modified, for switching over ModifiedMask::forEach
+        static constexpr size_t index = bit;
+
+        TrackedData() = default;
+
+        template<class Q>
+        requires (std::is_constructible_v<T, Q&&> && !std::is_same_v<std::remove_cvref_t<Q>, TrackedData>)
+        constexpr explicit(false) TrackedData(Q&& arg) : data(std::forward<Q>(arg)) {}
+
+        // the bit lives in the owner's mask, which the owner copies or moves along with its fields
+        TrackedData(TrackedData const&) = default;
+        TrackedData(TrackedData&&) noexcept(std::is_nothrow_move_constructible_v<T>) = default;
+
+        // like HeldData<bool>, a tracked bool only converts to whether it was modified
+        constexpr explicit(false) operator T const&() const noexcept requires (!std::is_same_v<T, bool>) {return data;}
+        explicit(false) constexpr operator bool() const noexcept {return isModified();}
+
+        [[nodiscard]] constexpr bool isModified() const noexcept {
+            return owner().modified.test(bit);
+        }
+
+        [[nodiscard]] constexpr T const& getData() const noexcept {
+            return data;
+        }
+
+        constexpr void clear() noexcept {
+            owner().modified.reset(bit);
+        }
+
+        constexpr TrackedData& operator=(TrackedData const& other) {
+            return *this = other.data;
+        }
+
+        /// @brief Moves the value of other, setting the bit of this field if it differs. The bit of other is left alone.
+        constexpr TrackedData& operator=(TrackedData&& other) {
+            return *this = std::move(other.data);
+        }
+
+        template<class U>
+        requires (std::is_assignable_v<T&, U const&>)
+        constexpr TrackedData& operator=(U const& other) {
+            if (data != other) {
+                owner().modified.set(bit);
+                detail::markWritten(this);
+                data = other;
+            }
+            return *this;
+        }
+
+        constexpr TrackedData& operator=(T&& other) {
+            if (data != other) {
+                owner().modified.set(bit);
+                detail::markWritten(this);
+                data = std::move(other);
+            }
+            return *this;
+        }
+
+        /// @brief Like HeldData<T>::operator=(U&&)
+        template<class U>
+        requires (detail::ModifiedValue<T>::versioned && std::is_same_v<U, typename detail::ModifiedValue<T>::type>)
+        constexpr TrackedData& operator=(U&& other) {
+            modify([&](U& value) { value = std::move(other); });
+            return *this;
+        }
+
+        /// @brief Like HeldData<T>::emplace
+        template<class... Args>
+        requires (std::is_constructible_v<T, Args&&...>)
+        constexpr T& emplace(Args&&... args) {
+            owner().modified.set(bit);
+            detail::markWritten(this);
+            data = T(std::forward<Args>(args)...);
+            return data;
+        }
+
+        /// @brief Like HeldData<T>::modify
+        template<class F>
+        requires (std::is_invocable_v<F&&, typename detail::ModifiedValue<T>::type&>)
+        constexpr decltype(auto) modify(F&& f) {
+            owner().modified.set(bit);
+            detail::markWritten(this);
+            return detail::modifyValue(data, std::forward<F>(f));
+        }
+
+        constexpr T const& operator ->() const noexcept {
+            return data;
+        }
+
+        constexpr T const& operator *() const noexcept {
+            return data;
+        }
+
+    private:
+        Owner const& owner() const noexcept {
+            static_assert(std::is_standard_layout_v<Owner>, "trackedOffset uses offsetof, which only works for standard layout types");
+            return *reinterpret_cast<Owner const*>(reinterpret_cast<char const*>(this) - Owner::trackedOffset(bit));
+        }
+
+        Owner& owner() noexcept {
+            return const_cast<Owner&>(std::as_const(*this).owner());
+        }
+
+        T data;
+    };
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace QUC {
+    /// @brief Counters of a ManagedStringCache, useful for sizing it
+    struct ManagedStringStats {
+        /// @brief Lookups answered with a cached string
+        size_t hits = 0;
+        /// @brief Lookups that had to create a string
+        size_t misses = 0;
+        /// @brief Strings dropped because the cache was full or cleared
+        size_t evicted = 0;
+
+        [[nodiscard]] constexpr float hitRate() const noexcept {
+            auto total = hits + misses;
+            return total == 0 ? 0.0f : static_cast<float>(hits) / static_cast<float>(total);
+        }
+    };
+
+    /// @brief Keeps the managed strings of recently set labels, so setting the same text again
+    /// reuses its managed string instead of allocating another one on the il2cpp heap.
+    /// Strings are looked up by content, and the least recently used one is dropped once the cache is full.
+    /// Cached strings are kept alive by the cache itself. Dropping one only releases that hold,
+    /// a text still showing it keeps it alive for as long as it needs it.
+    /// Backends use this for every string they hand to the game, see Backend::setText.
+    /// Must only be used on the main thread.
+    /// @tparam Traits Creates, unwraps and releases the strings of a backend:
+    /// `using String`, `static String create(std::string_view)`, `static auto get(String const&)` and `static void release(String&)`
+    template<typename Traits>
+    struct ManagedStringCache {
+        static constexpr size_t defaultCapacity = 256;
+
+        /// @brief The managed string with the contents of value, created if it isn't cached
+        static auto get(std::string_view value) {
+            if (auto it = index.find(value); it != index.end()) {
+                // most recently used first
+                entries.splice(entries.begin(), entries, it->second);
+                stats.hits++;
+                return Traits::get(it->second->string);
+            }
+
+            stats.misses++;
+            if (entries.size() >= capacity) {
+                evict();
+            }
+
+            auto& entry = entries.emplace_front(std::string(value), Traits::create(value));
+            index.emplace(entry.key, entries.begin());
+            return Traits::get(entry.string);
+        }
+
+        /// @brief Sets how many strings are kept at most, at least one.
+        /// Strings above the new capacity are dropped.
+        static void setCapacity(size_t newCapacity) {
+            capacity = newCapacity > 0 ? newCapacity : 1;
+            while (entries.size() > capacity) {
+                evict();
+            }
+        }
+
+        [[nodiscard]] static size_t getCapacity() noexcept {
+            return capacity;
+        }
+
+        [[nodiscard]] static size_t size() noexcept {
+            return entries.size();
+        }
+
+        [[nodiscard]] static ManagedStringStats const& getStats() noexcept {
+            return stats;
+        }
+
+        static void resetStats() noexcept {
+            stats = {};
+        }
+
+        /// @brief Drops every cached string
+        static void clear() {
+            while (!entries.empty()) {
+                evict();
+            }
+        }
+
+    private:
+        struct Entry {
+            std::string key;
+            typename Traits::String string;
+
+            Entry(std::string key, typename Traits::String string) : key(std::move(key)), string(std::move(string)) {}
+        };
+
+        static void evict() {
+            auto& entry = entries.back();
+            index.erase(entry.key);
+            Traits::release(entry.string);
+            entries.pop_back();
+            stats.evicted++;
+        }
+
+        // the index views the keys of the entries, list nodes never move
+        inline static std::list<Entry> entries;
+        inline static std::unordered_map<std::string_view, typename std::list<Entry>::iterator> index;
+        inline static size_t capacity = defaultCapacity;
+        inline static ManagedStringStats stats;
+    };
+}
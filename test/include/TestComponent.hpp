@@ -2,6 +2,7 @@
 
 #include "shared/components/Text.hpp"
 #include "shared/RootContainer.hpp"
+#include "shared/signal.hpp"
 
 #include <utility>
 #include <vector>
@@ -24,6 +25,8 @@ namespace QUC {
     struct MoreComplexType {
         // Identifies this component in the tree
         const Key key;
+        // Renders something different every time, even though nothing was modified
+        static constexpr bool alwaysRender = true;
 
         std::string prefix;
         std::array<Text, 4> texts = {Text(prefix + "text 1"), Text(prefix + "text 2"), Text(prefix + "text 3"), Text(prefix + "text 4")};
@@ -40,4 +43,23 @@ namespace QUC {
         }
     };
     static_assert(renderable<MoreComplexType>);
+
+    // Shows a counter kept outside of the tree, rendered again whenever it changes
+    struct ClicksText : Text {
+        Signal<int>& clicks;
+
+        ClicksText(Signal<int>& clicks) : clicks(clicks) {}
+
+        UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
+            // Shown without writing it to text: a write during render would mark this dirty again,
+            // and the next render would visit it once more for nothing
+            auto label = "Clicked " + std::to_string(*clicks) + " times";
+            if (auto textComp = data.getData<TMPro::TextMeshProUGUI*>()) {
+                QUC_NATIVE_CALL(Backend::setText(textComp, *italic ? italicized(label) : std::string_view(label)));
+            }
+            // creates the text showing label, if it doesn't exist yet
+            return renderText(ctx, data, label);
+        }
+    };
+    static_assert(renderable<ClicksText>);
 }
\ No newline at end of file
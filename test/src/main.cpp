@@ -16,6 +16,9 @@
 #include "shared/components/settings/IncrementSetting.hpp"
 #include "shared/components/settings/DropdownSetting.hpp"
 #include "shared/components/misc/RainbowText.hpp"
+#include "shared/scheduler.hpp"
+#include "shared/mount.hpp"
+#include "shared/mutations.hpp"
 
 // Custom components
 #include "TestComponent.hpp"
@@ -24,6 +27,8 @@
 
 #include "UnityEngine/UI/Image.hpp"
 
+#include <atomic>
+
 using namespace QuestUI;
 using namespace QuestUI_Components;
 using namespace QuestUI_Components::Loggerr;
@@ -49,7 +54,7 @@ extern "C" void setup(ModInfo& info) {
 #pragma region Loading
 
 
-auto HandleLoadingView(QUC::RenderContext& ctx, bool& loaded) {
+auto HandleLoadingView(QUC::RenderContext& ctx, std::atomic<bool>& loaded) {
     using namespace QUC;
 
     const std::string templateLoadingText = "Loading";
@@ -82,11 +87,13 @@ auto HandleLoadingView(QUC::RenderContext& ctx, bool& loaded) {
             if (periodCount > 4) periodCount = 1;
 
             std::string textStr(templateLoadingText + std::string(periodCount, '.'));
-            text.text = textStr;
+            // the main thread may be rendering the text right now, so let it apply the change itself
+            MutationQueue::post(text.text, std::move(textStr));
 
             QuestUI::MainThreadScheduler::Schedule([&ctx, &loaded]() mutable {
                 if (!loaded) {
-                    QUC::detail::renderSingle(view, ctx);
+                    // renders once per frame at most, no matter how often the text changes
+                    QUC::RenderScheduler::request(view, ctx);
 //                    // Destroy old hierarchy
 //                    UnityEngine::Object::Destroy(scrollTransform->get_gameObject());
 //                    // Updates the entire hierarchy
@@ -108,6 +115,9 @@ auto tuple(QUC::ModalWrapper& modal) {
     );
 }
 
+// Shared by several components, see ClicksText
+static QUC::Signal<int> clicks = 0;
+
 auto DefaultView(QUC::TacoImage& tacoImage) {
     using namespace QUC;
 
@@ -177,14 +187,23 @@ auto DefaultView(QUC::TacoImage& tacoImage) {
             QUC::VariableDropdownSetting("Dropdowns are cool!", "some val", [](VariableDropdownSetting& set, const std::string& selected, UnityEngine::Transform*, RenderContext& ctx){
                 getLogger().debug("Dropdowns are cool %s", selected.c_str());
                 set.text = "Dropdowns are coeaweol!" + selected;
-                auto list = set.values.getData();
-                list.emplace_back(std::to_string(list.size()));
-                set.values = list;
+                // appends without copying or comparing the list
+                set.values.modify([](std::vector<std::string>& list) {
+                    list.emplace_back(std::to_string(list.size()));
+                });
                 set.update(ctx);
             }, {"value1", "value2", "some val", "value3"}),
 
             HoverHint("hintee", Text("hello from other world!")),
             HoverHint("another hintee", Text("this is cooler!!")),
+            // Both texts update on their own, the button doesn't have to know about them
+            ClicksText(clicks),
+            Button("Count!", [](Button&, UnityEngine::Transform*, RenderContext&) {
+                clicks.modify([](int& count) { count++; });
+            }),
+            HorizontalLayoutGroup(
+                ClicksText(clicks)
+            ),
             Button("Click me!", [](Button& button, UnityEngine::Transform* parentTransform, RenderContext& ctx) {
                 static bool clicked = false;
                 static Text newText("New text!");
@@ -228,7 +247,7 @@ void DidActivate(HMUI::ViewController* self, bool firstActivation, bool addedToH
     if (firstActivation) {
         // keep these pointers alive so the lambdas can capture them. These would usually be instance fields in a ViewCoordinator
 
-        static bool loaded = false;
+        static std::atomic<bool> loaded = false;
 
         if (!loaded) {
             loadingViewTransform = HandleLoadingView(loadingCtx, loaded);
@@ -245,11 +264,17 @@ void DidActivate(HMUI::ViewController* self, bool firstActivation, bool addedToH
 
             QuestUI::MainThreadScheduler::Schedule([]() {
                 loaded = true;
+                RenderScheduler::cancel(loadingCtx);
                 loadingCtx.destroyTree();
 
-                QUC::detail::renderSingle(defaultView, ctx);
+                // Spread creating the view over a few frames
+                mountIncrementally(defaultView, ctx, {}, [] {
+                    // The loading text was handed to the pool by destroyTree and reused by the mount
+                    auto const& textPool = NativePool<Text>::getStats();
+                    getLogger().debug("Text pool: %zu created, %zu reused (%.0f%% hit rate)", textPool.created, textPool.reused, textPool.hitRate() * 100.0f);
+                });
 
-                // Multiple renders should simply just update, not crash or duplicate.
+                // Multiple renders should simply just update, not crash or duplicate, even while still mounting.
                 QUC::detail::renderSingle(defaultView, ctx);
                 QUC::detail::renderSingle(defaultView, ctx);
             });
@@ -0,0 +1,195 @@
+// Animator: tweens driven by frames of the headless backend, see HeadlessBackend::setDeltaTime.
+
+#include "check.hpp"
+
+#include "shared/animation.hpp"
+
+#include <vector>
+
+using namespace QUC;
+using B = Backend;
+
+namespace {
+    constexpr UnityEngine::Color red{1, 0, 0, 1};
+    constexpr UnityEngine::Color blue{0, 0, 1, 1};
+
+    /// @brief Runs one frame that took seconds
+    void frame(float seconds) {
+        B::setDeltaTime(seconds);
+        B::runFrame();
+    }
+
+    /// @brief Drops every tween, so the next test starts without any
+    void finish() {
+        Animator::clear();
+        frame(0);
+        CHECK_EQ(Animator::active(), 0u);
+        B::reset();
+    }
+
+    TMPro::TextMeshProUGUI* makeText(UnityEngine::GameObject* parent) {
+        return B::createText(parent->get_transform(), "Text", false, {0, 0}, {0, 0});
+    }
+
+    void onlyChangesAreWritten() {
+        auto root = B::createObject("Root");
+        auto text = makeText(root);
+
+        B::clearRecords();
+        auto color = Animator::color(text, red, blue, {.duration = 1});
+        auto alpha = Animator::alpha(text, 0.5f, 0.5f, {.duration = 10});
+        frame(0.25f);
+        CHECK_EQ(B::count(B::Op::SetColor), 1u);
+        CHECK_EQ(B::count(B::Op::SetAlpha), 1u);
+
+        // the alpha stays the same, so it's only set on the first frame
+        frame(0.25f);
+        CHECK_EQ(B::count(B::Op::SetColor), 2u);
+        CHECK_EQ(B::count(B::Op::SetAlpha), 1u);
+
+        // no time passed, nothing changed
+        frame(0);
+        CHECK_EQ(B::count(B::Op::SetColor), 2u);
+
+        // done, the color stops changing
+        frame(1);
+        CHECK_EQ(B::count(B::Op::SetColor), 3u);
+        CHECK(!color.running());
+        frame(1);
+        CHECK_EQ(B::count(B::Op::SetColor), 3u);
+        CHECK_EQ(B::count(B::Op::SetAlpha), 1u);
+        CHECK(alpha.running());
+
+        finish();
+    }
+
+    void destroyedHandleCancels() {
+        auto root = B::createObject("Root");
+        auto text = makeText(root);
+
+        B::clearRecords();
+        {
+            auto tween = Animator::color(text, red, blue, {.duration = 1});
+            frame(0.25f);
+            CHECK_EQ(B::count(B::Op::SetColor), 1u);
+        }
+        frame(0.25f);
+        CHECK_EQ(B::count(B::Op::SetColor), 1u);
+        CHECK_EQ(Animator::active(), 0u);
+
+        // assigning another tween cancels the one held before
+        auto tween = Animator::color(text, red, blue, {.duration = 1});
+        tween = Animator::color(text, blue, red, {.duration = 1});
+        frame(0.25f);
+        CHECK_EQ(B::count(B::Op::SetColor), 2u);
+        CHECK_EQ(Animator::active(), 1u);
+
+        finish();
+    }
+
+    void hiddenViewsPause() {
+        auto root = B::createObject("Root");
+        auto text = makeText(root);
+
+        B::clearRecords();
+        auto tween = Animator::alpha(text, 0, 1, {.duration = 1});
+        frame(0.25f);
+        CHECK_EQ(text->color.a, 0.25f);
+
+        root->SetActive(false);
+        frame(0.25f);
+        frame(0.25f);
+        CHECK_EQ(B::count(B::Op::SetAlpha), 1u);
+        CHECK_EQ(text->color.a, 0.25f);
+        CHECK(tween.running());
+
+        // continues where it was hidden
+        root->SetActive(true);
+        frame(0.25f);
+        CHECK_EQ(B::count(B::Op::SetAlpha), 2u);
+        CHECK_EQ(text->color.a, 0.5f);
+
+        finish();
+    }
+
+    void onceEndsOnItsTarget() {
+        // from + (to - from) is 0.099999994 in floats
+        constexpr float from = 0.3f;
+        constexpr float to = 0.1f;
+
+        for (auto easing : {Easing::Linear, Easing::InQuad, Easing::OutQuad, Easing::InOutQuad, Easing::InCubic,
+                            Easing::OutCubic, Easing::InOutCubic, Easing::InOutSine, Easing::OutBack}) {
+            float last = 0;
+            auto tween = Animator::value(from, to, [&](float value) { last = value; }, {.duration = 0.3f, .easing = easing});
+            for (int i = 0; i < 100 && tween.running(); i++) {
+                frame(1.0f / 90);
+            }
+            CHECK(!tween.running());
+            CHECK(last == to);
+        }
+
+        // also when a frame overshoots the end
+        auto text = makeText(B::createObject("Root"));
+        UnityEngine::Color target{0.35f, 0.1f, 0.1f, 0.35f};
+        auto tween = Animator::color(text, {1, 1, 1, 1}, target, {.duration = 0.3f, .easing = Easing::InOutSine});
+        frame(0.2f);
+        frame(0.2f);
+        CHECK(!tween.running());
+        CHECK(text->color == target);
+
+        finish();
+    }
+
+    void callbacksMayStartAndCancel() {
+        std::vector<Tween> started;
+        int startedCalls = 0;
+        int otherCalls = 0;
+
+        auto other = Animator::value(0, 1, [&](float) { otherCalls++; }, {.duration = 1});
+        Tween self;
+        auto starter = Animator::value(0, 1, [&](float) {
+            // enough to move the arrays of the Animator while this callback runs
+            for (int i = 0; i < 64; i++) {
+                started.push_back(Animator::value(0, 1, [&](float) { startedCalls++; }, {.duration = 1}));
+            }
+            other.cancel();
+            self.cancel();
+        }, {.duration = 1});
+        self = Animator::value(0, 1, [&](float) {
+            // cancels itself while it's being called
+            self.cancel();
+        }, {.duration = 1});
+
+        frame(0.25f);
+        CHECK_EQ(started.size(), 64u);
+        CHECK(!other.running());
+        CHECK(!self.running());
+        // other comes before starter, so it was called once before being cancelled
+        CHECK_EQ(otherCalls, 1);
+        // started ones start on the next frame
+        CHECK_EQ(startedCalls, 0);
+
+        starter.cancel();
+        frame(0.25f);
+        CHECK_EQ(startedCalls, 64);
+        CHECK_EQ(otherCalls, 1);
+        CHECK_EQ(Animator::active(), 64u);
+
+        started.clear();
+        frame(0.25f);
+        CHECK_EQ(startedCalls, 64);
+
+        finish();
+    }
+}
+
+int main() {
+    B::setRecording(true);
+
+    onlyChangesAreWritten();
+    destroyedHandleCancels();
+    hiddenViewsPause();
+    onceEndsOnItsTarget();
+    callbacksMayStartAndCancel();
+    return TEST_RESULT();
+}
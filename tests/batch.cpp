@@ -0,0 +1,152 @@
+// Batch: updates and signal notifications made inside a batch run once, when the outermost batch ends.
+
+#include "check.hpp"
+
+#include "shared/batch.hpp"
+#include "shared/signal.hpp"
+#include "shared/components/Button.hpp"
+#include "shared/components/settings/ToggleSetting.hpp"
+
+#include <string>
+
+using namespace QUC;
+using B = Backend;
+
+namespace {
+    /// @brief The value of the last SetText, records have to be on
+    std::string lastText() {
+        for (auto it = B::records().rbegin(); it != B::records().rend(); it++) {
+            if (it->op == B::Op::SetText) return it->value;
+        }
+        return {};
+    }
+
+    void buttonUpdatesOnce() {
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+        Button button("a", [](Button&, UnityEngine::Transform*, RenderContext&) {});
+        detail::renderSingle(button, ctx);
+
+        B::clearRecords();
+        batch([&] {
+            button.text = "b";
+            button.update(ctx);
+            button.enabled = false;
+            button.update(ctx);
+            button.text = "c";
+            button.update(ctx);
+            button.enabled = true;
+            button.update(ctx);
+            // nothing is set before the batch ends
+            CHECK_EQ(B::count(B::Op::SetText), 0u);
+            CHECK_EQ(B::count(B::Op::SetEnabled), 0u);
+        });
+        CHECK_EQ(B::count(B::Op::SetText), 1u);
+        CHECK_EQ(B::count(B::Op::SetEnabled), 1u);
+        CHECK(lastText() == "c");
+
+        // without a batch, each update sets what was written since the last one
+        B::clearRecords();
+        button.text = "d";
+        button.update(ctx);
+        button.text = "e";
+        button.update(ctx);
+        CHECK_EQ(B::count(B::Op::SetText), 2u);
+
+        ctx.destroyTree();
+        B::reset();
+    }
+
+    void toggleUpdatesOnce() {
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+        ToggleSetting toggle("a", [](ToggleSetting&, bool, UnityEngine::Transform*, RenderContext&) {});
+        detail::renderSingle(toggle, ctx);
+
+        B::clearRecords();
+        batch([&] {
+            for (auto text : {"b", "c", "d"}) {
+                toggle.text.text = text;
+                toggle.update(ctx);
+                toggle.setValue(text[0] == 'c');
+                toggle.update(ctx);
+            }
+        });
+        CHECK_EQ(B::count(B::Op::SetText), 1u);
+        // texts are italic by default
+        CHECK(lastText() == "<i>d</i>");
+        CHECK(!toggle.getValue());
+
+        ctx.destroyTree();
+        B::reset();
+    }
+
+    void nestedBatchesFlushOnce() {
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+        Button button("a", [](Button&, UnityEngine::Transform*, RenderContext&) {});
+        detail::renderSingle(button, ctx);
+
+        B::clearRecords();
+        {
+            Batch outer;
+            batch([&] {
+                button.text = "b";
+                button.update(ctx);
+            });
+            // the inner batch ended, but the outer one is still open
+            CHECK_EQ(B::count(B::Op::SetText), 0u);
+
+            batch([&] {
+                button.text = "c";
+                button.update(ctx);
+            });
+            CHECK_EQ(B::count(B::Op::SetText), 0u);
+        }
+        CHECK_EQ(B::count(B::Op::SetText), 1u);
+        CHECK(lastText() == "c");
+
+        ctx.destroyTree();
+        B::reset();
+    }
+
+    void signalNotifiesOnce() {
+        Signal<int> signal(0);
+        int computations = 0;
+        Computed<int> doubled([&] {
+            computations++;
+            return *signal * 2;
+        });
+        // reading doubled from another computed value keeps it observed, so it's recomputed as soon as signal changes
+        Computed<int> reader([&] { return *doubled; });
+        CHECK_EQ(*reader, 0);
+        CHECK_EQ(computations, 1);
+
+        batch([&] {
+            signal = 1;
+            signal = 2;
+            signal = 3;
+            // written right away, but nobody was told yet
+            CHECK_EQ(signal.peek(), 3);
+            CHECK_EQ(computations, 1);
+        });
+        CHECK_EQ(computations, 2);
+        CHECK_EQ(doubled.get(), 6);
+
+        signal = 4;
+        signal = 5;
+        CHECK_EQ(computations, 4);
+    }
+}
+
+int main() {
+    NativePool<Button>::setCapacity(0);
+    NativePool<ToggleSetting>::setCapacity(0);
+    B::setRecording(true);
+
+    buttonUpdatesOnce();
+    toggleUpdatesOnce();
+    nestedBatchesFlushOnce();
+    signalNotifiesOnce();
+    return TEST_RESULT();
+}
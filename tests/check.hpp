@@ -0,0 +1,77 @@
+#pragma once
+
+// Minimal checks for the host tests, so they build without a test framework.
+// Include from exactly one translation unit per test executable, it replaces the global operator new.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace quc_test {
+    inline int failures = 0;
+    /// @brief Every global allocation made so far, see allocationsDuring
+    inline std::atomic<size_t> allocations = 0;
+
+    template<typename F>
+    size_t allocationsDuring(F&& f) {
+        auto before = allocations.load();
+        f();
+        return allocations.load() - before;
+    }
+}
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            quc_test::failures++; \
+        } \
+    } while (false)
+
+#define CHECK_EQ(a, b) \
+    do { \
+        auto const& checkA = (a); \
+        auto const& checkB = (b); \
+        if (!(checkA == checkB)) { \
+            std::fprintf(stderr, "%s:%d: check failed: %s == %s (%lld vs %lld)\n", __FILE__, __LINE__, #a, #b, \
+                         static_cast<long long>(checkA), static_cast<long long>(checkB)); \
+            quc_test::failures++; \
+        } \
+    } while (false)
+
+/// @brief Exit status of a test executable, ctest fails it unless every check passed
+#define TEST_RESULT() (quc_test::failures == 0 ? 0 : 1)
+
+namespace quc_test {
+    // Not inlined into the operators, else GCC pairs the malloc with inlined operator deletes and warns about a mismatch
+
+    /// @brief Backs every replaced operator new, and counts it
+    [[gnu::noinline]] inline void* allocate(size_t size, size_t alignment = 0) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        size = std::max<size_t>(size, 1);
+        auto ptr = alignment == 0 ? std::malloc(size) : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+
+    /// @brief Backs every replaced operator delete
+    [[gnu::noinline]] inline void release(void* ptr) noexcept {
+        std::free(ptr);
+    }
+}
+
+void* operator new(size_t size) { return quc_test::allocate(size); }
+void* operator new[](size_t size) { return quc_test::allocate(size); }
+void operator delete(void* ptr) noexcept { quc_test::release(ptr); }
+void operator delete[](void* ptr) noexcept { quc_test::release(ptr); }
+void operator delete(void* ptr, size_t) noexcept { quc_test::release(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { quc_test::release(ptr); }
+// std::pmr::new_delete_resource allocates through these, whatever the alignment
+void* operator new(size_t size, std::align_val_t align) { return quc_test::allocate(size, static_cast<size_t>(align)); }
+void* operator new[](size_t size, std::align_val_t align) { return quc_test::allocate(size, static_cast<size_t>(align)); }
+void operator delete(void* ptr, std::align_val_t) noexcept { quc_test::release(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { quc_test::release(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { quc_test::release(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { quc_test::release(ptr); }
@@ -0,0 +1,137 @@
+// Dirty tracking: writes to HeldData only re-render the components holding them, see detail::DirtyTracker.
+
+#include "check.hpp"
+
+#include "shared/context.hpp"
+#include "shared/state.hpp"
+
+#include <thread>
+
+using namespace QUC;
+
+namespace {
+    struct Counter {
+        const Key key;
+        HeldData<int> value;
+        int renders = 0;
+
+        void render(RenderContext&, RenderContextChildData&) {
+            renders++;
+        }
+    };
+
+    struct Pair {
+        const Key key;
+        Counter first;
+        Counter second;
+
+        void render(RenderContext& ctx, RenderContextChildData&) {
+            detail::renderSingle(first, ctx);
+            detail::renderSingle(second, ctx);
+        }
+    };
+
+    void writesOnlyRenderTheirComponent() {
+        UnityEngine::Transform root;
+        RenderContext ctx(root);
+        Pair pair;
+        detail::renderSingle(pair, ctx);
+
+        pair.first.value = 1;
+        detail::renderSingle(pair, ctx);
+        CHECK_EQ(pair.first.renders, 2);
+        CHECK_EQ(pair.second.renders, 1);
+    }
+
+    void unownedWritesAreIgnored() {
+        UnityEngine::Transform root;
+        RenderContext ctx(root);
+        Pair pair;
+        detail::renderSingle(pair, ctx);
+
+        // not part of any rendered tree
+        HeldData<int> unrelated;
+        unrelated = 1;
+        Counter temporary;
+        temporary.value = 2;
+
+        detail::renderSingle(pair, ctx);
+        CHECK_EQ(pair.first.renders, 1);
+        CHECK_EQ(pair.second.renders, 1);
+    }
+
+    void repeatedWritesDontGrowTheBuffer() {
+        HeldData<int> a;
+        HeldData<int> b;
+        // the first writes of a thread allocate its buffer
+        a = -1;
+        detail::DirtyTracker::flush();
+
+        auto allocations = quc_test::allocationsDuring([&] {
+            for (int i = 0; i < 1'000'000; i++) {
+                a = i;
+                b = i;
+            }
+        });
+        CHECK_EQ(allocations, 0u);
+        detail::DirtyTracker::flush();
+    }
+
+    void droppedWritesRenderEverything() {
+        UnityEngine::Transform root;
+        RenderContext ctx(root);
+        Pair pair;
+        detail::renderSingle(pair, ctx);
+
+        std::vector<HeldData<int>> fields(detail::PendingWrites::capacity + 1);
+        for (auto& field : fields) field = 1;
+
+        detail::renderSingle(pair, ctx);
+        CHECK_EQ(pair.first.renders, 2);
+        CHECK_EQ(pair.second.renders, 2);
+
+        // and only once
+        detail::renderSingle(pair, ctx);
+        CHECK_EQ(pair.first.renders, 2);
+    }
+
+    void writesFromOtherThreads() {
+        UnityEngine::Transform root;
+        RenderContext ctx(root);
+        Pair pair;
+        detail::renderSingle(pair, ctx);
+
+        std::thread([&] { pair.second.value = 3; }).join();
+        detail::renderSingle(pair, ctx);
+        CHECK_EQ(pair.first.renders, 1);
+        CHECK_EQ(pair.second.renders, 2);
+    }
+
+    void batchedWrites() {
+        UnityEngine::Transform root;
+        RenderContext ctx(root);
+        Pair pair;
+        detail::renderSingle(pair, ctx);
+
+        detail::PendingWrites::hold();
+        for (int i = 0; i < 1000; i++) {
+            pair.first.value = i;
+            pair.second.value = i;
+        }
+        detail::PendingWrites::release();
+
+        detail::renderSingle(pair, ctx);
+        CHECK_EQ(pair.first.renders, 2);
+        CHECK_EQ(pair.second.renders, 2);
+    }
+}
+
+int main() {
+    writesOnlyRenderTheirComponent();
+    unownedWritesAreIgnored();
+    repeatedWritesDontGrowTheBuffer();
+    droppedWritesRenderEverything();
+    writesFromOtherThreads();
+    batchedWrites();
+    return TEST_RESULT();
+}
@@ -0,0 +1,94 @@
+// DropdownSetting: the values are handed to the dropdown without copying them, and only when they changed.
+
+#include "check.hpp"
+
+#include "shared/components/settings/DropdownSetting.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace QUC;
+using B = Backend;
+
+namespace {
+    /// @brief Values of a dropdown that count how often they are copied
+    struct CountedValues : std::vector<std::string> {
+        inline static int copies = 0;
+
+        using std::vector<std::string>::vector;
+        CountedValues(CountedValues const& other) : std::vector<std::string>(other) { copies++; }
+        CountedValues(CountedValues&&) noexcept = default;
+        CountedValues& operator=(CountedValues const& other) {
+            std::vector<std::string>::operator=(other);
+            copies++;
+            return *this;
+        }
+        CountedValues& operator=(CountedValues&&) noexcept = default;
+    };
+
+    using Setting = DropdownSetting<0, CountedValues>;
+
+    HMUI::SimpleTextDropdown* findDropdown(UnityEngine::GameObject* root) {
+        return root->get_transform()->GetChild(0)->GetChild(1)->GetComponent<HMUI::SimpleTextDropdown*>();
+    }
+
+    void valuesAreNotCopied() {
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+
+        CountedValues::copies = 0;
+        Setting setting("Setting", "b", [](Setting&, std::string const&, UnityEngine::Transform*, RenderContext&) {}, CountedValues{"a", "b"});
+        detail::renderSingle(setting, ctx);
+        auto dropdown = findDropdown(root);
+        CHECK_EQ(CountedValues::copies, 0);
+        CHECK_EQ(dropdown->texts.size(), 2u);
+        CHECK_EQ(dropdown->selectedIndex, 1);
+
+        B::clearRecords();
+        setting.values.modify([](CountedValues& values) { values.push_back("c"); });
+        setting.setValue("c");
+        setting.update(ctx);
+        CHECK_EQ(CountedValues::copies, 0);
+        CHECK_EQ(B::count(B::Op::SetDropdownTexts), 1u);
+        CHECK_EQ(dropdown->texts.size(), 3u);
+        CHECK_EQ(dropdown->selectedIndex, 2);
+
+        // picking another value doesn't hand the values over again
+        B::clearRecords();
+        setting.setValue("a");
+        setting.update(ctx);
+        CHECK_EQ(CountedValues::copies, 0);
+        CHECK_EQ(B::count(B::Op::SetDropdownTexts), 0u);
+        CHECK_EQ(dropdown->selectedIndex, 0);
+
+        ctx.destroyTree();
+        B::reset();
+    }
+
+    void selectingCallsBack() {
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+
+        std::string selected;
+        Setting setting("Setting", "a", [&](Setting&, std::string const& value, UnityEngine::Transform*, RenderContext&) {
+            selected = value;
+        }, CountedValues{"a", "b"});
+        detail::renderSingle(setting, ctx);
+
+        B::select(findDropdown(root), 1);
+        CHECK(selected == "b");
+        CHECK(setting.getValue() == "b");
+        // the dropdown already shows it
+        CHECK(!setting.value.isModified());
+
+        ctx.destroyTree();
+        B::reset();
+    }
+}
+
+int main() {
+    valuesAreNotCopied();
+    selectingCallsBack();
+    return TEST_RESULT();
+}
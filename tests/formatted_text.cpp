@@ -0,0 +1,65 @@
+// FormattedText: created with the formatted values, updated through char arrays without managed strings.
+
+#include "check.hpp"
+
+#include "shared/components/FormattedText.hpp"
+#include "shared/components/layouts/VerticalLayoutGroup.hpp"
+
+#include <string>
+
+using namespace QUC;
+using B = Backend;
+
+namespace {
+    using Combo = FormattedText<"Combo {} ({:.2}s)", int, double>;
+
+    struct CountingCombo : Combo {
+        using Combo::Combo;
+        int renders = 0;
+
+        UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
+            renders++;
+            return Combo::render(ctx, data);
+        }
+    };
+
+    std::string shownText(UnityEngine::Transform* transform) {
+        return transform->get_gameObject()->GetComponent<TMPro::TextMeshProUGUI*>()->text;
+    }
+
+    void createdWithTheFormattedValues() {
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+
+        CountingCombo combo(3, 1.5, true, std::nullopt, 4, false);
+        auto view = VerticalLayoutGroup(combo, Text("other"));
+        auto& shown = std::get<0>(view.children);
+
+        detail::renderSingle(view, ctx);
+        auto transform = root->get_transform()->GetChild(0)->GetChild(0);
+        CHECK(shownText(transform) == "Combo 3 (1.50s)");
+        CHECK(shown.text.getData().empty());
+
+        // creating it didn't write to anything, so nothing is rendered again
+        detail::renderSingle(view, ctx);
+        CHECK_EQ(shown.renders, 1);
+
+        B::clearRecords();
+        shown.set(4, 2.25);
+        detail::renderSingle(view, ctx);
+        CHECK(shownText(transform) == "Combo 4 (2.25s)");
+        CHECK_EQ(B::count(B::Op::SetCharArray), 1u);
+        CHECK_EQ(B::count(B::Op::SetText), 0u);
+
+        ctx.destroyTree();
+        B::reset();
+    }
+}
+
+int main() {
+    NativePool<Text>::setCapacity(0);
+    NativePool<UnityEngine::UI::VerticalLayoutGroup>::setCapacity(0);
+
+    createdWithTheFormattedValues();
+    return TEST_RESULT();
+}
@@ -0,0 +1,160 @@
+// InlineFunction and UniqueFunction: small callables are stored in place, so copying components with callbacks doesn't allocate.
+
+#include "check.hpp"
+
+#include "shared/function.hpp"
+#include "shared/components/Button.hpp"
+#include "shared/components/layouts/VerticalLayoutGroup.hpp"
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using namespace QUC;
+using B = Backend;
+
+namespace {
+    struct Counted {
+        inline static int copies = 0;
+        inline static int alive = 0;
+        void* padding = nullptr;
+
+        Counted() { alive++; }
+        Counted(Counted const&) { copies++; alive++; }
+        Counted(Counted&&) noexcept { alive++; }
+        ~Counted() { alive--; }
+    };
+
+    void smallCallablesAreInline() {
+        Counted counted;
+        Counted::copies = 0;
+        size_t allocations = quc_test::allocationsDuring([&] {
+            InlineFunction<int(int)> f = [counted, x = 3](int y) mutable { return x++ + y; };
+            CHECK_EQ(f(1), 4);
+            // the captures belong to the function, and keep their changes
+            CHECK_EQ(f(1), 5);
+
+            auto copy = f;
+            auto moved = std::move(copy);
+            CHECK(!copy);
+            CHECK_EQ(moved(0), 5);
+            CHECK_EQ(f(0), 5);
+        });
+        CHECK_EQ(allocations, 0u);
+        CHECK_EQ(Counted::copies, 2);
+    }
+
+    void bigCallablesAreOnTheHeap() {
+        char big[64] = {1};
+        InlineFunction<int()> f;
+        CHECK_EQ(quc_test::allocationsDuring([&] { f = [big] { return static_cast<int>(big[0]); }; }), 1u);
+        CHECK_EQ(f(), 1);
+
+        InlineFunction<int()> copy;
+        CHECK_EQ(quc_test::allocationsDuring([&] { copy = f; }), 1u);
+        // moving hands over the heap allocation
+        InlineFunction<int()> moved;
+        CHECK_EQ(quc_test::allocationsDuring([&] { moved = std::move(copy); }), 0u);
+        CHECK(!copy);
+        CHECK_EQ(moved(), 1);
+    }
+
+    void emptySourcesMakeEmptyFunctions() {
+        InlineFunction<int(int)> empty;
+        CHECK(!empty);
+        CHECK(empty == nullptr);
+
+        std::function<int(int)> emptyStd;
+        InlineFunction<int(int)> fromStd = emptyStd;
+        CHECK(!fromStd);
+
+        int (*null)(int) = nullptr;
+        InlineFunction<int(int)> fromPointer = null;
+        CHECK(!fromPointer);
+
+        InlineFunction<int(int)> reset = [](int y) { return y; };
+        reset = nullptr;
+        CHECK(!reset);
+    }
+
+    void callingAnEmptyFunctionThrows() {
+        InlineFunction<void()> empty;
+        bool thrown = false;
+        try {
+            empty();
+        } catch (std::bad_function_call const&) {
+            thrown = true;
+        }
+        CHECK(thrown);
+    }
+
+    void uniqueFunctionsTakeMoveOnlyCallables() {
+        static_assert(!std::is_copy_constructible_v<UniqueFunction<int()>>);
+        static_assert(std::is_copy_constructible_v<InlineFunction<int()>>);
+        static_assert(!std::is_constructible_v<InlineFunction<int()>, decltype([p = std::unique_ptr<int>()] { return 0; })>);
+
+        UniqueFunction<int()> f = [p = std::make_unique<int>(7)] { return *p; };
+        auto moved = std::move(f);
+        CHECK(!f);
+        CHECK_EQ(moved(), 7);
+    }
+
+    void capturesAreDestroyed() {
+        Counted::alive = 0;
+        {
+            Counted counted;
+            InlineFunction<void()> f = [counted] {};
+            auto copy = f;
+            char big[64] = {};
+            InlineFunction<void()> heap = [counted, big] { (void) big; };
+            auto heapCopy = heap;
+        }
+        CHECK_EQ(Counted::alive, 0);
+    }
+
+    void copyingButtonsDoesNotAllocate() {
+        int clicks = 0;
+        Counted counted;
+        Button prototype("x", [&clicks, counted](Button&, UnityEngine::Transform*, RenderContext&) { clicks++; });
+
+        std::vector<Button> buttons;
+        buttons.reserve(100);
+        Counted::copies = 0;
+        size_t allocations = quc_test::allocationsDuring([&] {
+            for (int i = 0; i < 100; i++) buttons.push_back(prototype);
+        });
+        CHECK_EQ(allocations, 0u);
+        CHECK_EQ(Counted::copies, 100);
+
+        // rendering doesn't copy the callback either, and clicking calls it
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+        auto view = VerticalLayoutGroup(Button(prototype));
+        Counted::copies = 0;
+        detail::renderSingle(view, ctx);
+        CHECK_EQ(Counted::copies, 0);
+
+        auto button = root->get_transform()->GetChild(0)->GetChild(0)->get_gameObject()->GetComponent<UnityEngine::UI::Button*>();
+        B::click(button);
+        B::click(button);
+        CHECK_EQ(clicks, 2);
+
+        ctx.destroyTree();
+        B::reset();
+    }
+}
+
+int main() {
+    NativePool<Button>::setCapacity(0);
+    NativePool<UnityEngine::UI::VerticalLayoutGroup>::setCapacity(0);
+
+    smallCallablesAreInline();
+    bigCallablesAreOnTheHeap();
+    emptySourcesMakeEmptyFunctions();
+    callingAnEmptyFunctionThrows();
+    uniqueFunctionsTakeMoveOnlyCallables();
+    capturesAreDestroyed();
+    copyingButtonsDoesNotAllocate();
+    return TEST_RESULT();
+}
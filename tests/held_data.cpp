@@ -0,0 +1,127 @@
+// HeldData: values are moved or changed in place instead of copied, also when posted from another thread.
+
+#include "check.hpp"
+
+#include "shared/state.hpp"
+#include "shared/mutations.hpp"
+
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace QUC;
+
+namespace {
+    struct Counted {
+        inline static int copies = 0;
+        inline static int moves = 0;
+
+        std::string value;
+
+        Counted() = default;
+        explicit Counted(std::string value) : value(std::move(value)) {}
+        Counted(Counted const& other) : value(other.value) { copies++; }
+        Counted(Counted&& other) noexcept : value(std::move(other.value)) { moves++; }
+        Counted& operator=(Counted const& other) { value = other.value; copies++; return *this; }
+        Counted& operator=(Counted&& other) noexcept { value = std::move(other.value); moves++; return *this; }
+
+        bool operator==(Counted const& other) const { return value == other.value; }
+
+        static void reset() {
+            copies = 0;
+            moves = 0;
+        }
+    };
+
+    void constructionMoves() {
+        Counted::reset();
+        HeldData<Counted> field(Counted("value"));
+        CHECK_EQ(Counted::copies, 0);
+        CHECK_EQ(Counted::moves, 1);
+        CHECK(field.getData().value == "value");
+
+        Counted::reset();
+        HeldData<Counted> moved(std::move(field));
+        CHECK_EQ(Counted::copies, 0);
+        CHECK_EQ(Counted::moves, 1);
+        CHECK(moved.getData().value == "value");
+    }
+
+    void assignmentMoves() {
+        HeldData<Counted> field;
+
+        Counted::reset();
+        field = Counted("value");
+        CHECK_EQ(Counted::copies, 0);
+        CHECK_EQ(Counted::moves, 1);
+        CHECK(field.isModified());
+
+        // equal values are compared, not moved in
+        field.clear();
+        Counted::reset();
+        field = Counted("value");
+        CHECK_EQ(Counted::copies, 0);
+        CHECK_EQ(Counted::moves, 0);
+        CHECK(!field.isModified());
+
+        HeldData<Counted> other(Counted("other"));
+        Counted::reset();
+        field = std::move(other);
+        CHECK_EQ(Counted::copies, 0);
+        CHECK_EQ(Counted::moves, 1);
+        CHECK(field.getData().value == "other");
+
+        // copying a field is still a copy
+        HeldData<Counted> source(Counted("source"));
+        Counted::reset();
+        field = source;
+        CHECK_EQ(Counted::copies, 1);
+    }
+
+    void emplaceAndModifyDontCopy() {
+        HeldData<Counted> field;
+
+        Counted::reset();
+        field.emplace("emplaced");
+        CHECK_EQ(Counted::copies, 0);
+        CHECK(field.getData().value == "emplaced");
+        CHECK(field.isModified());
+
+        field.clear();
+        Counted::reset();
+        field.modify([](Counted& value) { value.value += "!"; });
+        CHECK_EQ(Counted::copies, 0);
+        CHECK_EQ(Counted::moves, 0);
+        CHECK(field.getData().value == "emplaced!");
+        CHECK(field.isModified());
+    }
+
+    void postingMoves() {
+        HeldData<Counted> field;
+
+        Counted::reset();
+        std::thread([&] {
+            MutationQueue::post(field, Counted("first"));
+            // replaces the pending value
+            MutationQueue::post(field, Counted("second"));
+        }).join();
+        MutationQueue::drain();
+        CHECK_EQ(Counted::copies, 0);
+        CHECK(field.getData().value == "second");
+
+        Counted::reset();
+        Counted value("third");
+        MutationQueue::post(field, std::move(value));
+        MutationQueue::drain();
+        CHECK_EQ(Counted::copies, 0);
+        CHECK(field.getData().value == "third");
+    }
+}
+
+int main() {
+    constructionMoves();
+    assignmentMoves();
+    emplaceAndModifyDontCopy();
+    postingMoves();
+    return TEST_RESULT();
+}
@@ -0,0 +1,65 @@
+// KeyMap: a reserved map allocates once, and values keep their address while it grows.
+
+#include "check.hpp"
+
+#include "shared/KeyMap.hpp"
+
+#include <vector>
+
+using namespace QUC;
+
+namespace {
+    void reservedMapAllocatesOnce() {
+        std::vector<Key> keys(10);
+        KeyMap<int> map;
+        auto allocations = quc_test::allocationsDuring([&] {
+            map.reserve(keys.size());
+            for (size_t i = 0; i < keys.size(); i++) map[keys[i]] = static_cast<int>(i);
+        });
+        CHECK_EQ(allocations, 1u);
+        CHECK_EQ(map.size(), keys.size());
+        for (size_t i = 0; i < keys.size(); i++) CHECK_EQ(*map.find(keys[i]), static_cast<int>(i));
+    }
+
+    void valuesStayWhereTheyAre() {
+        std::vector<Key> keys(1000);
+        KeyMap<int> map;
+        map.reserve(2);
+        std::vector<int*> values;
+        for (size_t i = 0; i < keys.size(); i++) {
+            auto [value, inserted] = map.tryEmplace(keys[i], static_cast<int>(i));
+            CHECK(inserted);
+            values.push_back(value);
+        }
+        for (size_t i = 0; i < keys.size(); i++) {
+            CHECK(map.find(keys[i]) == values[i]);
+            CHECK_EQ(*values[i], static_cast<int>(i));
+        }
+
+        // erased entries are reused, also where the first bucket array was
+        for (size_t i = 0; i < keys.size(); i += 2) map.erase(keys[i]);
+        std::vector<Key> more(500);
+        for (auto const& key : more) map[key] = -1;
+        for (size_t i = 1; i < keys.size(); i += 2) CHECK_EQ(*map.find(keys[i]), static_cast<int>(i));
+        for (auto const& key : more) CHECK_EQ(*map.find(key), -1);
+        CHECK_EQ(map.size(), keys.size() / 2 + more.size());
+    }
+
+    void releasedMapCanBeReused() {
+        Key key;
+        KeyMap<int> map;
+        map.reserve(4);
+        map[key] = 1;
+        map.release();
+        CHECK(map.empty());
+        map[key] = 2;
+        CHECK_EQ(*map.find(key), 2);
+    }
+}
+
+int main() {
+    reservedMapAllocatesOnce();
+    valuesStayWhereTheyAre();
+    releasedMapCanBeReused();
+    return TEST_RESULT();
+}
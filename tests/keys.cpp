@@ -0,0 +1,58 @@
+// Key: ids handed out from thread local blocks are unique across threads, and their hashes are too.
+
+#include "check.hpp"
+
+#include "shared/key.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace QUC;
+
+namespace {
+    constexpr size_t threadCount = 4;
+    constexpr size_t keysPerThread = 2'000'000;
+
+    void keysAreUniqueAcrossThreads() {
+        std::vector<std::vector<size_t>> hashes(threadCount);
+        std::vector<std::thread> threads;
+        for (auto& own : hashes) {
+            threads.emplace_back([&own]() {
+                own.reserve(keysPerThread);
+                for (size_t i = 0; i < keysPerThread; i++) {
+                    own.push_back(std::hash<Key>()(Key()));
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        std::vector<size_t> all;
+        all.reserve(threadCount * keysPerThread);
+        for (auto const& own : hashes) all.insert(all.end(), own.begin(), own.end());
+        std::sort(all.begin(), all.end());
+
+        // mixKey is a bijection, so equal hashes mean an id was handed out twice
+        CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+        // id 0 is never handed out
+        CHECK(!std::binary_search(all.begin(), all.end(), static_cast<size_t>(detail::mixKey(0))));
+    }
+
+    void keysOnlyEqualTheirCopies() {
+        Key a;
+        Key b;
+        Key copy = a;
+        CHECK(a == copy);
+        CHECK(!(a == b));
+        CHECK(std::hash<Key>()(a) == std::hash<Key>()(copy));
+        CHECK(std::hash<Key>()(a) != std::hash<Key>()(b));
+    }
+}
+
+int main() {
+    keysAreUniqueAcrossThreads();
+    keysOnlyEqualTheirCopies();
+    return TEST_RESULT();
+}
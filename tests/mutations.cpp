@@ -0,0 +1,215 @@
+// MutationQueue: producers posting from several threads while the render thread drains.
+// Also built with ThreadSanitizer as quc_test_mutations_tsan, see CMakeLists.txt.
+
+#include "check.hpp"
+
+#include "shared/context.hpp"
+#include "shared/state.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace QUC;
+
+namespace {
+    struct Label {
+        const Key key;
+        HeldData<std::string> text;
+        HeldData<int> count;
+        std::string renderedText;
+        int renderedCount = 0;
+
+        void render(RenderContext&, RenderContextChildData&) {
+            renderedText = *text;
+            renderedCount = *count;
+        }
+    };
+
+    void producersAndRenderThread() {
+        UnityEngine::Transform root;
+        RenderContext ctx(root);
+        Label label;
+
+        constexpr int producers = 4;
+        constexpr int perProducer = 20000;
+        std::atomic<int> closures = 0;
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; p++) {
+            threads.emplace_back([&, p] {
+                for (int i = 1; i <= perProducer; i++) {
+                    if (p == 0) MutationQueue::post(label.count, i);
+                    MutationQueue::post(label.text, "p" + std::to_string(p) + " " + std::to_string(i));
+                    if (i % 100 == 0) MutationQueue::post([&] { closures.fetch_add(1, std::memory_order_relaxed); });
+                }
+            });
+        }
+
+        // the render thread only ever sees the writes of one producer in posting order
+        int last = 0;
+        bool ordered = true;
+        while (label.renderedCount != perProducer || closures.load() != producers * perProducer / 100) {
+            detail::renderSingle(label, ctx);
+            ordered &= label.renderedCount >= last;
+            last = label.renderedCount;
+        }
+        for (auto& thread : threads) thread.join();
+        MutationQueue::drain();
+
+        CHECK(ordered);
+        CHECK(MutationQueue::empty());
+        CHECK_EQ(*label.count, perProducer);
+    }
+
+    void slotsChangeFieldsUnderContention() {
+        // more fields than slots, written in a window moving over them, so slots are claimed and given up while writing
+        std::vector<HeldData<int>> fields(MutationQueue::slotCount * 3);
+        constexpr int producers = 4;
+        constexpr int rounds = 200;
+        std::atomic<int> done = 0;
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; p++) {
+            threads.emplace_back([&, p] {
+                for (int round = 1; round <= rounds; round++) {
+                    // each field is only ever written by one producer
+                    size_t window = fields.size() / producers * round / rounds * producers;
+                    for (size_t i = 0; i < 64; i++) {
+                        MutationQueue::post(fields[(window + i * producers + p) % fields.size()], round);
+                    }
+                }
+                done.fetch_add(1, std::memory_order_release);
+            });
+        }
+
+        while (done.load(std::memory_order_acquire) != producers) {
+            MutationQueue::drain();
+            detail::DirtyTracker::flush();
+        }
+        for (auto& thread : threads) thread.join();
+        MutationQueue::drain();
+        detail::DirtyTracker::flush();
+
+        // the last window was written in the last round
+        bool written = true;
+        for (size_t i = 0; i < 64 * producers; i++) written &= *fields[i] == rounds;
+        CHECK(written);
+        CHECK(MutationQueue::empty());
+    }
+
+    /// @brief Gives up the slots of fields an earlier test wrote to
+    void releaseSlots() {
+        for (uint64_t i = 0; i < MutationQueue::idleDrains; i++) MutationQueue::drain();
+    }
+
+    void coalescesWrites() {
+        HeldData<int> count;
+        for (int i = 0; i < 1000; i++) MutationQueue::post(count, i);
+        CHECK_EQ(MutationQueue::drain(), 1u);
+        CHECK_EQ(*count, 999);
+    }
+
+    void closuresSeeEarlierWrites() {
+        HeldData<int> count;
+        int observed = -1;
+        MutationQueue::post(count, 5);
+        MutationQueue::drain();
+
+        // the field is queued after the closure, which sees the applied value
+        MutationQueue::post([&] { observed = *count; });
+        MutationQueue::post(count, 6);
+        CHECK_EQ(MutationQueue::drain(), 2u);
+        CHECK_EQ(observed, 5);
+        CHECK_EQ(*count, 6);
+
+        // the field is queued before the closure, and already holds the newer write when it's applied
+        MutationQueue::post(count, 7);
+        MutationQueue::post([&] { observed = *count; });
+        MutationQueue::post(count, 8);
+        CHECK_EQ(MutationQueue::drain(), 2u);
+        CHECK_EQ(observed, 8);
+    }
+
+    void postingDoesNotAllocate() {
+        HeldData<int> count;
+        std::vector<HeldData<int>> fields(64);
+        auto postAll = [&](int value) {
+            for (auto& field : fields) MutationQueue::post(field, value);
+        };
+
+        // the first writes claim the slots, and their values get a spare
+        for (int i = 0; i < 3; i++) {
+            MutationQueue::post(count, i);
+            MutationQueue::post(count, i + 1);
+            postAll(i);
+            postAll(i + 1);
+            MutationQueue::drain();
+        }
+
+        auto allocations = quc_test::allocationsDuring([&] {
+            for (int i = 0; i < 1'000'000; i++) MutationQueue::post(count, i);
+            postAll(1);
+            MutationQueue::drain();
+            postAll(2);
+        });
+        CHECK_EQ(allocations, 0u);
+        CHECK_EQ(MutationQueue::drain(), fields.size());
+
+        // pending work is one slot per field, however often it's written
+        for (int i = 0; i < 1'000'000; i++) MutationQueue::post(count, i);
+        CHECK_EQ(MutationQueue::drain(), 1u);
+        CHECK_EQ(*count, 999'999);
+        detail::DirtyTracker::flush();
+    }
+
+    void writesBeyondTheSlotsAreApplied() {
+        std::vector<HeldData<int>> fields(MutationQueue::slotCount * 2);
+        for (auto& field : fields) MutationQueue::post(field, 1);
+        for (auto& field : fields) MutationQueue::post(field, 2);
+
+        auto applied = MutationQueue::drain();
+        // fields without a slot are written once per post
+        CHECK(applied >= fields.size() && applied <= fields.size() * 2);
+        bool all = true;
+        for (auto& field : fields) all &= *field == 2;
+        CHECK(all);
+        detail::DirtyTracker::flush();
+    }
+
+    void drainDoesNotAllocate() {
+        std::vector<HeldData<int>> fields(64);
+        auto postAll = [&] {
+            for (int round = 0; round < 4; round++) {
+                for (auto& field : fields) MutationQueue::post(field, round);
+                MutationQueue::post([] {});
+            }
+        };
+
+        // warm up the scratch buffers, the applied writes are resolved like a render would
+        for (int i = 0; i < 2; i++) {
+            postAll();
+            MutationQueue::drain();
+            detail::DirtyTracker::flush();
+        }
+
+        postAll();
+        size_t applied = 0;
+        CHECK_EQ(quc_test::allocationsDuring([&] { applied = MutationQueue::drain(); }), 0u);
+        // each field once, and every closure
+        CHECK_EQ(applied, fields.size() + 4);
+    }
+}
+
+int main() {
+    producersAndRenderThread();
+    slotsChangeFieldsUnderContention();
+    releaseSlots();
+    coalescesWrites();
+    closuresSeeEarlierWrites();
+    postingDoesNotAllocate();
+    writesBeyondTheSlotsAreApplied();
+    releaseSlots();
+    drainDoesNotAllocate();
+    return TEST_RESULT();
+}
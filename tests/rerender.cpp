@@ -0,0 +1,71 @@
+// Re-rendering: a mounted tree whose state didn't change renders again without allocating, see docs/README.md.
+
+#include "check.hpp"
+
+#include "shared/RootContainer.hpp"
+#include "shared/components/Text.hpp"
+#include "shared/components/Button.hpp"
+#include "shared/components/settings/ToggleSetting.hpp"
+#include "shared/components/layouts/VerticalLayoutGroup.hpp"
+#include "shared/components/layouts/HorizontalLayoutGroup.hpp"
+
+using namespace QUC;
+using B = Backend;
+
+namespace {
+    auto makeView() {
+        return VerticalLayoutGroup(
+            Text("Header"),
+            HorizontalLayoutGroup(
+                Button("Apply", [](Button&, UnityEngine::Transform*, RenderContext&) {}),
+                ToggleSetting("Enabled", [](ToggleSetting&, bool, UnityEngine::Transform*, RenderContext&) {})
+            ),
+            detail::VariableContainer<Text>{Text("a"), Text("b"), Text("c")}
+        );
+    }
+
+    void unchangedTreeDoesntAllocate() {
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+        auto view = makeView();
+
+        detail::renderSingle(view, ctx);
+        CHECK_EQ(quc_test::allocationsDuring([&] { detail::renderSingle(view, ctx); }), 0u);
+        // and keeps not allocating
+        CHECK_EQ(quc_test::allocationsDuring([&] { detail::renderSingle(view, ctx); }), 0u);
+
+        ctx.destroyTree();
+        B::reset();
+    }
+
+    void unchangedAfterUpdateDoesntAllocate() {
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+        auto view = makeView();
+        detail::renderSingle(view, ctx);
+
+        auto& row = std::get<1>(view.children);
+        std::get<0>(row.children).text = "Applied";
+        std::get<1>(row.children).setValue(true);
+        std::get<2>(view.children).children[1].text = "d";
+        detail::renderSingle(view, ctx);
+
+        CHECK_EQ(quc_test::allocationsDuring([&] { detail::renderSingle(view, ctx); }), 0u);
+
+        ctx.destroyTree();
+        B::reset();
+    }
+}
+
+int main() {
+    // pools would hand out natives without allocating, measure the tree instead
+    NativePool<Text>::setCapacity(0);
+    NativePool<Button>::setCapacity(0);
+    NativePool<ToggleSetting>::setCapacity(0);
+    NativePool<UnityEngine::UI::VerticalLayoutGroup>::setCapacity(0);
+    NativePool<UnityEngine::UI::HorizontalLayoutGroup>::setCapacity(0);
+
+    unchangedTreeDoesntAllocate();
+    unchangedAfterUpdateDoesntAllocate();
+    return TEST_RESULT();
+}
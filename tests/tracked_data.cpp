@@ -0,0 +1,128 @@
+// TrackedData: values are moved instead of copied, and the modified bits stay with the owner's mask.
+
+#include "check.hpp"
+
+#include "shared/state.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+using namespace QUC;
+
+namespace {
+    struct Counted {
+        inline static int copies = 0;
+        inline static int moves = 0;
+
+        std::string value;
+
+        Counted() = default;
+        explicit Counted(std::string value) : value(std::move(value)) {}
+        Counted(Counted const& other) : value(other.value) { copies++; }
+        Counted(Counted&& other) noexcept : value(std::move(other.value)) { moves++; }
+        Counted& operator=(Counted const& other) { value = other.value; copies++; return *this; }
+        Counted& operator=(Counted&& other) noexcept { value = std::move(other.value); moves++; return *this; }
+
+        bool operator==(Counted const& other) const { return value == other.value; }
+
+        static void reset() {
+            copies = 0;
+            moves = 0;
+        }
+    };
+
+    struct Owner {
+        ModifiedMask<2> modified;
+        TrackedData<Counted, Owner, 0> first;
+        TrackedData<Counted, Owner, 1> second;
+
+        static constexpr size_t trackedOffset(size_t bit) {
+            return std::array{offsetof(Owner, first), offsetof(Owner, second)}[bit];
+        }
+    };
+
+    void moveAssignmentMoves() {
+        Owner a;
+        Owner b;
+        a.first = Counted("value");
+        a.modified.clear();
+
+        Counted::reset();
+        b.first = std::move(a.first);
+        CHECK_EQ(Counted::copies, 0);
+        CHECK_EQ(Counted::moves, 1);
+        CHECK(b.first.getData().value == "value");
+        CHECK(b.first.isModified());
+        CHECK(!b.second.isModified());
+        // the source keeps its own bit
+        CHECK(!a.first.isModified());
+    }
+
+    void equalMoveAssignmentIsNoChange() {
+        Owner a;
+        Owner b;
+        a.first = Counted("same");
+        b.first = Counted("same");
+        b.modified.clear();
+
+        Counted::reset();
+        b.first = std::move(a.first);
+        CHECK_EQ(Counted::copies, 0);
+        CHECK(!b.first.isModified());
+    }
+
+    void copyAssignmentCopiesOnce() {
+        Owner a;
+        Owner b;
+        a.first = Counted("value");
+
+        Counted::reset();
+        b.first = a.first;
+        CHECK_EQ(Counted::copies, 1);
+        CHECK(b.first.isModified());
+        CHECK(a.first.getData().value == "value");
+    }
+
+    void movingTheOwnerKeepsItsBits() {
+        Owner a;
+        a.first = Counted("value");
+        a.second = Counted("other");
+        a.second.clear();
+
+        Counted::reset();
+        Owner b(std::move(a));
+        CHECK_EQ(Counted::copies, 0);
+        CHECK_EQ(Counted::moves, 2);
+        CHECK(b.first.isModified());
+        CHECK(!b.second.isModified());
+        CHECK(b.first.getData().value == "value");
+
+        Counted::reset();
+        Owner c(b);
+        CHECK_EQ(Counted::copies, 2);
+        CHECK(c.first.isModified());
+        CHECK(!c.second.isModified());
+    }
+
+    void assigningAValueMovesIt() {
+        Owner a;
+        Counted value("value");
+
+        Counted::reset();
+        a.first = std::move(value);
+        CHECK_EQ(Counted::copies, 0);
+        CHECK_EQ(Counted::moves, 1);
+        CHECK(a.first.isModified());
+    }
+}
+
+int main() {
+    moveAssignmentMoves();
+    equalMoveAssignmentIsNoChange();
+    copyAssignmentCopiesOnce();
+    movingTheOwnerKeepsItsBits();
+    assigningAValueMovesIt();
+    return TEST_RESULT();
+}
@@ -0,0 +1,152 @@
+// VariableContainer: children changed between renders are reconciled, even when nothing above them was written to.
+
+#include "check.hpp"
+
+#include "shared/RootContainer.hpp"
+#include "shared/components/Text.hpp"
+#include "shared/components/layouts/VerticalLayoutGroup.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+using namespace QUC;
+using B = Backend;
+
+namespace {
+    void childrenChangedInsideLayout() {
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+
+        auto view = VerticalLayoutGroup(detail::VariableContainer<Text>{Text("a"), Text("b")});
+        auto& list = std::get<0>(view.children).children;
+
+        detail::renderSingle(view, ctx);
+        auto layout = root->get_transform()->GetChild(0);
+        CHECK_EQ(layout->GetChildCount(), 2);
+
+        list.push_back(Text("c"));
+        detail::renderSingle(view, ctx);
+        CHECK_EQ(layout->GetChildCount(), 3);
+        CHECK_EQ(B::count(B::Op::CreateText), 3u);
+
+        list.pop_back();
+        detail::renderSingle(view, ctx);
+        CHECK_EQ(layout->GetChildCount(), 2);
+
+        // unchanged, the existing texts are neither created nor updated again
+        B::clearRecords();
+        detail::renderSingle(view, ctx);
+        CHECK_EQ(B::count(B::Op::CreateText), 0u);
+        CHECK_EQ(B::count(B::Op::SetText), 0u);
+        CHECK_EQ(layout->GetChildCount(), 2);
+
+        ctx.destroyTree();
+        B::reset();
+    }
+
+    void siblingsOfTheListAreStillSkipped() {
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+
+        struct CountingText : Text {
+            using Text::Text;
+            int* renders;
+
+            UnityEngine::Transform* render(RenderContext& ctx, RenderContextChildData& data) {
+                (*renders)++;
+                return Text::render(ctx, data);
+            }
+        };
+
+        int headerRenders = 0;
+        CountingText header("header");
+        header.renders = &headerRenders;
+        auto view = VerticalLayoutGroup(VerticalLayoutGroup(header), detail::VariableContainer<Text>{Text("a")});
+
+        detail::renderSingle(view, ctx);
+        std::get<1>(view.children).children.push_back(Text("b"));
+        detail::renderSingle(view, ctx);
+        detail::renderSingle(view, ctx);
+        CHECK_EQ(headerRenders, 1);
+
+        ctx.destroyTree();
+        B::reset();
+    }
+
+    void reorderingAllocatesFromTheContextResource() {
+        auto root = B::createObject("Root");
+        // anything not allocated from the context's resource shows up as a global allocation
+        std::array<std::byte, 1 << 16> buffer;
+        std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+        RenderContext ctx(root->get_transform(), &resource);
+
+        auto view = detail::VariableContainer<Text>{Text("a"), Text("b"), Text("c")};
+        detail::renderSingle(view, ctx);
+        auto transform = root->get_transform();
+        auto first = transform->GetChild(0);
+        auto last = transform->GetChild(2);
+
+        std::vector<Text> reversed;
+        reversed.reserve(view.children.size());
+        for (auto it = view.children.rbegin(); it != view.children.rend(); it++) reversed.push_back(*it);
+        view.children.swap(reversed);
+
+        CHECK_EQ(quc_test::allocationsDuring([&] { detail::renderSingle(view, ctx); }), 0u);
+        CHECK(transform->GetChild(0) == last);
+        CHECK(transform->GetChild(2) == first);
+
+        ctx.destroyTree();
+        B::reset();
+    }
+
+    struct CountedText : Text {
+        inline static int copies = 0;
+
+        using Text::Text;
+        CountedText(CountedText const& other) : Text(other) { copies++; }
+        CountedText(CountedText&&) noexcept = default;
+    };
+
+    void updatesDontCopyChildren() {
+        auto root = B::createObject("Root");
+        RenderContext ctx(root->get_transform());
+
+        std::vector<CountedText> children;
+        children.emplace_back("a");
+        children.emplace_back("b");
+        CountedText::copies = 0;
+        detail::VariableContainer<CountedText> view(std::move(children));
+        detail::renderSingle(view, ctx);
+        CHECK_EQ(CountedText::copies, 0);
+
+        view.children.emplace_back("c");
+        view.children.front().text = "changed";
+        detail::renderSingle(view, ctx);
+
+        // texts aren't assignable, so reordering moves them into a new list
+        std::vector<CountedText> reversed;
+        reversed.reserve(view.children.size());
+        for (auto it = view.children.rbegin(); it != view.children.rend(); it++) reversed.push_back(std::move(*it));
+        view.children = std::move(reversed);
+        detail::renderSingle(view, ctx);
+        CHECK_EQ(CountedText::copies, 0);
+        CHECK_EQ(root->get_transform()->GetChildCount(), 3);
+
+        ctx.destroyTree();
+        B::reset();
+    }
+}
+
+int main() {
+    // pools would outlive Backend::reset()
+    NativePool<Text>::setCapacity(0);
+    NativePool<UnityEngine::UI::VerticalLayoutGroup>::setCapacity(0);
+
+    childrenChangedInsideLayout();
+    siblingsOfTheListAreStillSkipped();
+    reorderingAllocatesFromTheContextResource();
+    updatesDontCopyChildren();
+    return TEST_RESULT();
+}